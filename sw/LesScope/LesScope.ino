@@ -42,6 +42,7 @@
  * Rotaryencoder/Button:
  *  encoder turn  left/right: menu activating, selection and changing data.
  *  button short  press     : mark and store selected data.
+ *                            re-arms the single-shot trigger on draws.
  *  button double press     : back to previous menu (only if menu is active).
  *  button long   press     : saving configuration-data to EEPROM.
  *
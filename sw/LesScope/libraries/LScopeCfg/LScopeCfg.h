@@ -57,6 +57,8 @@
 #define SET_AMP_LEVEL_2  2
 #define SET_AMP_LEVEL_3  3
 #define SET_AMP_LEVEL_4  4
+//channel1 auto-range: level 1...4 is set from the sample-range
+#define SET_AMP_AUTO     5
 #define SET_OFF          false
 #define SET_ON           true
 #define SET_TRIG_OFF     0
@@ -64,8 +66,71 @@
 #define SET_TRIG_AUTO_N  2
 #define SET_TRIG_NORM_P  3
 #define SET_TRIG_NORM_N  4
+//single-shot: one frame is captured and kept, re-armed by button
+#define SET_TRIG_SINGLE_P 5
+#define SET_TRIG_SINGLE_N 6
 #define SET_TRIG_LEVEL_INTERN  0
 #define SET_TRIG_LEVEL_EXTERN  1
+//software trigger on the 10bit-conversions of channel1/channel2, the
+// level is SWTRIG_MID + SWTRIG_STEP * trigger_sw_level, the hysteresis
+// SWTRIG_STEP * trigger_hyst. The slope follows the trigger-mode.
+#define SET_TRIG_LEVEL_SOFT1   2
+#define SET_TRIG_LEVEL_SOFT2   3
+#define SWTRIG_MID           512
+#define SWTRIG_STEP            4
+#define SET_TRIG_HYST_MAX     31
+//trigger-times (holdoff, qualifier) in 1-2-5 steps 50usec...500msec
+#define SET_TRIG_TIMES        13
+//trigger-holdoff: edges are ignored for a time or a number of edges
+// after every accepted one.
+#define SET_HOLDOFF_OFF        0
+#define SET_HOLDOFF_TIME       1
+#define SET_HOLDOFF_EDGES      2
+#define SET_HOLDOFF_EDGES_MAX 99
+//trigger-qualifier on the analog comparator: a pulse starts with the
+// edge of the trigger-mode, it triggers on its end, if it's wider or
+// narrower than the qualifier-time. dropout triggers, if no edge is
+// following within the qualifier-time.
+#define SET_QUAL_EDGE          0
+#define SET_QUAL_WIDER         1
+#define SET_QUAL_NARROWER      2
+#define SET_QUAL_DROPOUT       3
+//trigger-divider: every Nth trigger-edge starts a frame. With reset
+// only the Nth edge after a reset-pulse on channel2: rising above
+// DIV_RESET_HIGH after being below DIV_RESET_LOW (10bit-conversions).
+#define SET_TRIG_DIV_MAX      64
+#define DIV_RESET_HIGH       640
+#define DIV_RESET_LOW        576
+#define SET_PRETRIG_0    0
+#define SET_PRETRIG_25   1
+#define SET_PRETRIG_50   2
+#define SET_PRETRIG_75   3
+//acquisition-modes (channel1 menu), used on sample-times of 100usec or more
+//  HiRes: every sample-tick is converted and averaged per sample
+//  Peak : min/max of every sample-tick, stored as pairs of samples
+//  Roll : free running, the display scrolls with every new sample
+//  Segm.: SEGMENT_FRAMES triggered frames back-to-back, single channel
+//  Avg. : exponential average of triggered frames, single channel
+//  Deep : DEEP_SAMPLES packed samples per frame, channel1 only
+#define SET_ACQ_NORMAL   0
+#define SET_ACQ_HIRES    1
+#define SET_ACQ_PEAK     2
+#define SET_ACQ_ROLL     3
+#define SET_ACQ_SEGMENT  4
+#define SET_ACQ_AVERAGE  5
+#define SET_ACQ_DEEP     6
+//number of averaged frames: 2^SET_AVG_xxx
+#define SET_AVG_2        1
+#define SET_AVG_8        3
+#define SET_AVG_64       6
+//fine sample-time: channel sample-times are stretched by time_fine/64
+#define SET_FINE_MAX     96
+//period-locked display: triggered frames are resampled to show
+// 2^(SET_LOCK_xxx-1) periods of the measured channel1 frequency
+#define SET_LOCK_OFF     0
+#define SET_LOCK_1       1
+#define SET_LOCK_2       2
+#define SET_LOCK_4       3
 
 //menu option values
 #define SET_OPT_SINGLE       1
@@ -76,22 +141,62 @@
 
 #define TRIGGER_TIMEOUT_VALUE_MSEC 2000
 
-//TIMERSCALE values
-#define TIMER2_SAMPLE   100 //50usec sample-time
-#define TIMER2_50USEC     0
-#define TIMER2_01MSEC     1
-#define TIMER2_02MSEC     3
-#define TIMER2_05MSEC     9
-#define TIMER2_1MSEC     19
-#define TIMER2_2MSEC     39
-#define TIMER2_5MSEC     99
-#define TIMER2_10MSEC   199
-#define TIMER2_20MSEC   399
-#define TIMER2_50MSEC   999
-#define TIMER2_100MSEC 1999
+//TIMER2 PWM-TOP value (OCR2A), used for offset-voltage on channel1
+#define TIMER2_SAMPLE   100
+
+//TIMER1 compare-steps for sample-tick, timer1 runs with clk/1
+#define TIMER1_SAMPLE   800 //50usec sample-time
+//fraction of the compare-step in 1/64 cycles, fine sample-times are
+// accumulated like a DDS-phase on every sample-tick
+#define TIMER1_FINE_SHIFT  6
+#define TIMER1_FINE_ONE    (1<<TIMER1_FINE_SHIFT)
+//fast acquisition sample-ticks, ADC with prescaler /8 and 8bit reads
+#define TIMER1_SAMPLE_10USEC 160 //10usec sample-time
+#define TIMER1_SAMPLE_20USEC 320 //20usec sample-time
+//phase-locked sample-tick: the first post-trigger sample is converted
+// this delay after the comparator-edge, if the sample-tick could be
+// moved at least TIMER1_PHASE_MARGIN cycles ahead
+#define TIMER1_PHASE_DELAY   160 //10usec
+#define TIMER1_PHASE_MARGIN   32
+//burst-capture, no sample-tick: ADC free running with 13 ADC-clocks
+// on prescaler /8 -->> 6.5usec (13usec per channel on dual)
+#define TIMER1_SAMPLE_BURST    0
+//  max. cpu-cycles blocked by a dual channel capture (first result is
+//  dropped), has to be below the timer1 overflow period of FreqMeasure
+#define BURST_BLOCK_CYCLES   ((2UL*SAMPLE_DATA_SIZE + 1) * 13 * 8)
+//equivalent-time sampling (ETS): real sample-tick of ~21usec, dithered
+// by ETS_DITHER_MASK, every sample is placed by its time after the
+// trigger-edge into slots of ETS_SLOT_CYCLES (2usec)
+#define TIMER1_SAMPLE_ETS    336
+#define ETS_DITHER_MASK       31
+#define ETS_SLOT_CYCLES       32
+//finish an ETS-frame after this number of trigger-events
+#define ETS_MAX_TRIGGERS      64
+
+//TIMERSCALE values, number of 50usec sample-ticks to be skipped
+#define TIMER1_ETS        0
+#define TIMER1_BURST      0
+#define TIMER1_10USEC     0
+#define TIMER1_20USEC     0
+#define TIMER1_50USEC     0
+#define TIMER1_01MSEC     1
+#define TIMER1_02MSEC     3
+#define TIMER1_05MSEC     9
+#define TIMER1_1MSEC     19
+#define TIMER1_2MSEC     39
+#define TIMER1_5MSEC     99
+#define TIMER1_10MSEC   199
+#define TIMER1_20MSEC   399
+#define TIMER1_50MSEC   999
+#define TIMER1_100MSEC 1999
 
 //sample-data memory-size
 #define SAMPLE_DATA_SIZE  128
+//segmented memory: both channel1 buffers and the unused channel2 ones
+#define SEGMENT_FRAMES      4
+//deep memory: packed 6bit samples, 4 samples in 3 bytes, stored in the
+// data of the channel1 buffers and the unused channel2 memory
+#define DEEP_SAMPLES      512
 
 //////////////////////////////////////////
 //sw-revision of LesScope
@@ -100,6 +205,8 @@
 
 // value-check for range
 #define range(checkit,low,high) ((checkit)<(low)?(low):((checkit)>(high)?(high):(checkit)))
+// trigger-modes on the positive slope
+#define trigger_positive(mode) (((mode)==SET_TRIG_AUTO_P)||((mode)==SET_TRIG_NORM_P)||((mode)==SET_TRIG_SINGLE_P))
 
 typedef struct channel_val {
   uint8_t status;    //0:= channel off, 1:= on
@@ -108,6 +215,19 @@ typedef struct channel_val {
   int8_t  offset;
   uint8_t trigger_mode;
   uint8_t trigger_level;
+  int8_t  trigger_sw_level;
+  uint8_t trigger_hyst;
+  uint8_t holdoff_mode;
+  uint8_t holdoff;   //time-index or number of edges
+  uint8_t trigger_qual;
+  uint8_t qual_time; //time-index
+  uint8_t trigger_div;
+  uint8_t div_reset; //SET_OFF, SET_ON:= reset by channel2
+  uint8_t pretrigger;
+  uint8_t acquisition;
+  uint8_t average;
+  uint8_t time_fine; //stretch of the sample-time in 1/64
+  uint8_t period_lock;
   uint8_t option;
   bool     sample_draw;
   bool     sample_start;
@@ -127,7 +247,12 @@ typedef struct cfg {
 
 // EEPROM Addresses
 #define ADDR_CHECKSUM            0
+#define ADDR_CFG_LAYOUT          1
 #define ADDR_CFG_DATA_BASE       2
+// layout of the stored cfg-data, renew CFG_LAYOUT_VERSION on changes of
+//  channel_val_t, which don't change its size
+#define CFG_LAYOUT_VERSION       2
+#define CFG_LAYOUT               ((uint8_t)((CFG_LAYOUT_VERSION << 6) ^ sizeof(cfg_t)))
 
 // global used config.data for exchange between LScopeMenu and LSsample
 extern cfg_t g_cfg;
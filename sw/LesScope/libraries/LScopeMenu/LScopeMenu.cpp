@@ -79,6 +79,7 @@ CMenu::CMenu(uint16_t w, uint16_t h, SPIClass *spi, int16_t dc_pin, int16_t rst_
   init_cfg();
   _menuctrl.menu_updated = true;
   _menuctrl.rowindex = 1;
+  _menuctrl.rowoffset = 0;
   _menuctrl.cursor_x=52;
   _menuctrl.cursor_y=_index2_ypixel(_menuctrl.rowindex);
   _menuctrl.mark_on = false;
@@ -175,6 +176,16 @@ void CMenu::updateMenu(void) {
       break;
     case SETTINGS:
       _prev_menu = SETTINGS;
+      if ((g_cfg.selected_channel == eChannel_nr1) &&
+          (_menuctrl.rowindex == MENU_ROW_AUTOSET))
+      {
+        //nothing to select, autoset and show the samples
+        _autoset();
+        _menu_state = DRAW_SAMPLES;
+        _menutimer.expired = true;
+        this->clearDisplay();
+        break;
+      }
       _menu_state = SELECT_VALUES;
       _menutimer.Timeout = millis();
       if (_menutimer.expired) {
@@ -193,6 +204,13 @@ void CMenu::updateMenu(void) {
       break;
     case DRAW_SAMPLES:
       _prev_menu = DRAW_SAMPLES;
+      if ((g_cfg.chan[eChannel_nr1].trigger_mode == SET_TRIG_SINGLE_P) ||
+          (g_cfg.chan[eChannel_nr1].trigger_mode == SET_TRIG_SINGLE_N))
+      {
+        //single-shot: the button re-arms, the encoder opens the menu
+        sample_single_arm();
+        break;
+      }
       _menu_state = MENU_DEFAULT;
       _menutimer.expired=false;
       break;
@@ -258,40 +276,13 @@ void CMenu::updateSelection(void) {
         _menutimer.Timeout = millis();
       }
       if (g_cfg.selected_channel == eChannel_nr1) {
-        _menuctrl.rowindex = range(select_rowindex,1,7);
+        _menuctrl.rowindex = range(select_rowindex,1,MENU_ROWS_CHANNEL1);
       } else {
-        _menuctrl.rowindex = range(select_rowindex,1,4);
+        _menuctrl.rowindex = range(select_rowindex,1,MENU_ROWS_CHANNEL2);
       }
       _defaultMenu();
       if ( _menuctrl.menu_updated ) {
-        //// set parameter for channel1 ////
-        //set amplifier
-        set_amplifier(eChannel_nr1);
-        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-          //renew counter-values
-          set_counter_defaults();
-          //set trigger-mode
-          set_trigger_mode(eChannel_nr1);
-          //set trigger-level
-          set_trigger_level();
-          //allocate/deallocate memory for channel2 if required
-          if ((g_cfg.chan[eChannel_nr1].option == SET_OPT_DUAL) ||
-              (g_cfg.chan[eChannel_nr1].option == SET_OPT_DUAL_PLUGGED))
-          {
-            if(pchannel2 == NULL) {
-              pchannel2 = new sample_t;
-            }
-          } else {
-            if(pchannel2 != NULL) {
-              delete pchannel2;
-              pchannel2 = NULL;
-            }
-          }
-        } //end ATOMIC_BLOCK()
-
-        //// set parameter for channel2 ////
-        //set amplifier
-        set_amplifier(eChannel_nr2);
+        _apply_settings();
         _menuctrl.menu_updated = false;
       }
 
@@ -300,6 +291,17 @@ void CMenu::updateSelection(void) {
       _defaultMenu();
     break;
     case DRAW_SAMPLES:
+      if ((_in_drawupdate == false) && (_is_view_selectable() == false) &&
+          this->rotaryencoder.turned())
+      {
+        //encoder turned while drawing: open the menu
+        _menu_state = MENU_DEFAULT;
+        _menutimer.expired=false;
+        _defaultMenu();
+        _menutimer.Timeout = millis();
+        break;
+      }
+      _select_draw_view();
       _draw_channels();
     break;
     case SAVE_REQUEST:
@@ -334,9 +336,14 @@ void CMenu::updateSelection(void) {
   if (_menutimer.expired) {
     _menu_state = DRAW_SAMPLES;
   }
-  if (rotaryencoder.update()) {
+  //the encoder is read by the main-loop only, never by Drawupdate()
+  if ((_in_drawupdate == false) && rotaryencoder.update()) {
     switch (_menu_state) {
       case DRAW_SAMPLES :
+        if (_is_view_selectable()) {
+          //the encoder selects the view, the button opens the menu
+          break;
+        }
         _menu_state = MENU_DEFAULT;
         _menutimer.expired=false;
         _menutimer.Timeout= millis();
@@ -358,6 +365,47 @@ void CMenu::updateSelection(void) {
   }
 }
 
+/*!
+ *
+ * name: _apply_settings
+ * @brief  sets the hardware and sampling to the current configuration.
+ * @param  none
+ * @return none
+ *
+ */
+void CMenu::_apply_settings(void) {
+  //// set parameter for channel1 ////
+  //set amplifier
+  set_amplifier(eChannel_nr1);
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    //sample-time limits could depend on changed option
+    _check_time_limits();
+    //assign/release the memory of channel2 if required
+    if ((g_cfg.chan[eChannel_nr1].option == SET_OPT_DUAL) ||
+        (g_cfg.chan[eChannel_nr1].option == SET_OPT_DUAL_PLUGGED))
+    {
+      sample_alloc_channel2(true);
+    } else {
+      sample_alloc_channel2(false);
+    }
+    //segmented memory, averaging and deep memory are using the
+    //  memory of channel2
+    sample_alloc_segments(g_cfg.chan[eChannel_nr1].acquisition == SET_ACQ_SEGMENT);
+    sample_alloc_average(g_cfg.chan[eChannel_nr1].acquisition == SET_ACQ_AVERAGE);
+    sample_alloc_deep(g_cfg.chan[eChannel_nr1].acquisition == SET_ACQ_DEEP);
+    //renew counter-values
+    set_counter_defaults();
+    //set trigger-mode
+    set_trigger_mode(eChannel_nr1);
+    //set trigger-level
+    set_trigger_level();
+  } //end ATOMIC_BLOCK()
+
+  //// set parameter for channel2 ////
+  //set amplifier
+  set_amplifier(eChannel_nr2);
+}
+
 /*!
  *
  * name: CheckMenuTimeout
@@ -405,6 +453,7 @@ void CMenu::CheckMenuTimeout(void)
  *
  */
 void CMenu::Drawupdate(void) {
+  _in_drawupdate = true;
   if (this->_menu_state == DRAW_SAMPLES) {
     if (g_cfg.chan[eChannel_nr1].trigger_mode == SET_OFF) {
         updateSelection();    // Refresh screen
@@ -415,6 +464,7 @@ void CMenu::Drawupdate(void) {
       }
     }
   }
+  _in_drawupdate = false;
 }
 
 /*!
@@ -436,6 +486,19 @@ void CMenu::init_cfg(void)
   g_cfg.chan[eChannel_nr1].offset = 0;
   g_cfg.chan[eChannel_nr1].option = SET_OPT_SINGLE;
   g_cfg.chan[eChannel_nr1].trigger_level = SET_TRIG_LEVEL_INTERN;
+  g_cfg.chan[eChannel_nr1].trigger_sw_level = 0;
+  g_cfg.chan[eChannel_nr1].trigger_hyst = 2;
+  g_cfg.chan[eChannel_nr1].holdoff_mode = SET_HOLDOFF_OFF;
+  g_cfg.chan[eChannel_nr1].holdoff = 4;
+  g_cfg.chan[eChannel_nr1].trigger_qual = SET_QUAL_EDGE;
+  g_cfg.chan[eChannel_nr1].qual_time = 4;
+  g_cfg.chan[eChannel_nr1].trigger_div = 1;
+  g_cfg.chan[eChannel_nr1].div_reset = SET_OFF;
+  g_cfg.chan[eChannel_nr1].pretrigger = SET_PRETRIG_0;
+  g_cfg.chan[eChannel_nr1].acquisition = SET_ACQ_NORMAL;
+  g_cfg.chan[eChannel_nr1].average = SET_AVG_8;
+  g_cfg.chan[eChannel_nr1].time_fine = 0;
+  g_cfg.chan[eChannel_nr1].period_lock = SET_LOCK_OFF;
   g_cfg.chan[eChannel_nr1].sample_draw = true;
   g_cfg.chan[eChannel_nr1].sample_start= true;
   //channel2 config
@@ -446,6 +509,19 @@ void CMenu::init_cfg(void)
   g_cfg.chan[eChannel_nr2].trigger_mode = SET_OFF;
   g_cfg.chan[eChannel_nr2].option = SET_OFF;
   g_cfg.chan[eChannel_nr2].trigger_level = SET_TRIG_LEVEL_INTERN;
+  g_cfg.chan[eChannel_nr2].trigger_sw_level = 0;
+  g_cfg.chan[eChannel_nr2].trigger_hyst = 2;
+  g_cfg.chan[eChannel_nr2].holdoff_mode = SET_HOLDOFF_OFF;
+  g_cfg.chan[eChannel_nr2].holdoff = 4;
+  g_cfg.chan[eChannel_nr2].trigger_qual = SET_QUAL_EDGE;
+  g_cfg.chan[eChannel_nr2].qual_time = 4;
+  g_cfg.chan[eChannel_nr2].trigger_div = 1;
+  g_cfg.chan[eChannel_nr2].div_reset = SET_OFF;
+  g_cfg.chan[eChannel_nr2].pretrigger = SET_PRETRIG_0;
+  g_cfg.chan[eChannel_nr2].acquisition = SET_ACQ_NORMAL;
+  g_cfg.chan[eChannel_nr2].average = SET_AVG_8;
+  g_cfg.chan[eChannel_nr2].time_fine = 0;
+  g_cfg.chan[eChannel_nr2].period_lock = SET_LOCK_OFF;
   g_cfg.chan[eChannel_nr2].sample_draw = true;
   g_cfg.chan[eChannel_nr2].sample_start= true;
 
@@ -453,18 +529,38 @@ void CMenu::init_cfg(void)
     //get cfg-data from EEPROM
     cfg_t eeprom_data;
     EEPROM.get(ADDR_CFG_DATA_BASE, eeprom_data);
-    //store required eeprom-data to global cfg-data
+    //store required eeprom-data to global cfg-data, every value is
+    //  limited to its menu-range
     // channel1 config
-    g_cfg.chan[eChannel_nr1].amplifier    = eeprom_data.chan[eChannel_nr1].amplifier;
-    g_cfg.chan[eChannel_nr1].time         = eeprom_data.chan[eChannel_nr1].time;
-    g_cfg.chan[eChannel_nr1].trigger_mode = eeprom_data.chan[eChannel_nr1].trigger_mode;
-    g_cfg.chan[eChannel_nr1].offset       = eeprom_data.chan[eChannel_nr1].offset;
-    g_cfg.chan[eChannel_nr1].option       = eeprom_data.chan[eChannel_nr1].option;
-    g_cfg.chan[eChannel_nr1].trigger_level= eeprom_data.chan[eChannel_nr1].trigger_level;
+    const channel_val_t & chan1 = eeprom_data.chan[eChannel_nr1];
+    g_cfg.chan[eChannel_nr1].amplifier    = range(chan1.amplifier, SET_AMP_LEVEL_1, SET_AMP_AUTO);
+    g_cfg.chan[eChannel_nr1].time         = range(chan1.time, MENU_TIM_ETS_VALUE, MENU_TIM_100MS_VALUE);
+    g_cfg.chan[eChannel_nr1].trigger_mode = range(chan1.trigger_mode, SET_TRIG_OFF, SET_TRIG_SINGLE_N);
+    g_cfg.chan[eChannel_nr1].offset       = (int8_t)range(chan1.offset, -31, 31);
+    g_cfg.chan[eChannel_nr1].option       = range(chan1.option, SET_OPT_SINGLE, SET_OPT_TUNING);
+    g_cfg.chan[eChannel_nr1].trigger_level= range(chan1.trigger_level, SET_TRIG_LEVEL_INTERN, SET_TRIG_LEVEL_SOFT2);
+    g_cfg.chan[eChannel_nr1].trigger_sw_level = (int8_t)range(chan1.trigger_sw_level, -127, 126);
+    g_cfg.chan[eChannel_nr1].trigger_hyst = range(chan1.trigger_hyst, 0, SET_TRIG_HYST_MAX);
+    g_cfg.chan[eChannel_nr1].holdoff_mode = range(chan1.holdoff_mode, SET_HOLDOFF_OFF, SET_HOLDOFF_EDGES);
+    if (g_cfg.chan[eChannel_nr1].holdoff_mode == SET_HOLDOFF_TIME) {
+      g_cfg.chan[eChannel_nr1].holdoff    = range(chan1.holdoff, 0, SET_TRIG_TIMES - 1);
+    } else {
+      g_cfg.chan[eChannel_nr1].holdoff    = range(chan1.holdoff, 1, SET_HOLDOFF_EDGES_MAX);
+    }
+    g_cfg.chan[eChannel_nr1].trigger_qual = range(chan1.trigger_qual, SET_QUAL_EDGE, SET_QUAL_DROPOUT);
+    g_cfg.chan[eChannel_nr1].qual_time    = range(chan1.qual_time, 0, SET_TRIG_TIMES - 1);
+    g_cfg.chan[eChannel_nr1].trigger_div  = range(chan1.trigger_div, 1, SET_TRIG_DIV_MAX);
+    g_cfg.chan[eChannel_nr1].div_reset    = (chan1.div_reset == SET_ON) ? SET_ON : SET_OFF;
+    g_cfg.chan[eChannel_nr1].pretrigger   = range(chan1.pretrigger, SET_PRETRIG_0, SET_PRETRIG_75);
+    g_cfg.chan[eChannel_nr1].acquisition  = range(chan1.acquisition, SET_ACQ_NORMAL, SET_ACQ_DEEP);
+    g_cfg.chan[eChannel_nr1].average      = range(chan1.average, SET_AVG_2, SET_AVG_64);
+    g_cfg.chan[eChannel_nr1].time_fine    = range(chan1.time_fine, 0, SET_FINE_MAX);
+    g_cfg.chan[eChannel_nr1].period_lock  = range(chan1.period_lock, SET_LOCK_OFF, SET_LOCK_4);
     // channel2 config
-    g_cfg.chan[eChannel_nr2].amplifier    = eeprom_data.chan[eChannel_nr2].amplifier;
-    g_cfg.chan[eChannel_nr2].time         = eeprom_data.chan[eChannel_nr2].time;
-    g_cfg.chan[eChannel_nr2].offset       = eeprom_data.chan[eChannel_nr2].offset;
+    const channel_val_t & chan2 = eeprom_data.chan[eChannel_nr2];
+    g_cfg.chan[eChannel_nr2].amplifier    = range(chan2.amplifier, SET_AMP_LEVEL_1, SET_AMP_LEVEL_2);
+    g_cfg.chan[eChannel_nr2].time         = range(chan2.time, MENU_TIM_50US_VALUE, MENU_TIM_100MS_VALUE);
+    g_cfg.chan[eChannel_nr2].offset       = (int8_t)range(chan2.offset, -31, 31);
   }
 }
 
@@ -503,22 +599,30 @@ void CMenu::_print_value_str(const uint8_t index, const channel_nr_t channel_nr,
     case 2:
       if (bchangevalue) {
         if (channel_nr == eChannel_nr1) {
-          g_cfg.chan[eChannel_nr1].amplifier = range(select_value, SET_AMP_LEVEL_1, SET_AMP_LEVEL_4);
+          g_cfg.chan[eChannel_nr1].amplifier = range(select_value, SET_AMP_LEVEL_1, SET_AMP_AUTO);
         } else {
           g_cfg.chan[eChannel_nr2].amplifier = range(select_value, SET_AMP_LEVEL_1, SET_AMP_LEVEL_2);
         }
       }
-      this->print(g_cfg.chan[channel_nr].amplifier);
+      if ((channel_nr == eChannel_nr1) &&
+          (g_cfg.chan[eChannel_nr1].amplifier == SET_AMP_AUTO))
+      {
+        this->print(F("Auto "));
+        this->print(amplifier_level());
+      } else {
+        this->print(g_cfg.chan[channel_nr].amplifier);
+      }
     break;
     case 3:
       if (bchangevalue) {
         ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-          g_cfg.chan[channel_nr].time = range(select_value, MENU_TIM_50US_VALUE, MENU_TIM_100MS_VALUE);
-          //channel2 sampling-time depends on channel1,
-          // sampling-time could be faster, but not less
-          if ( (g_cfg.chan[eChannel_nr2].time) > g_cfg.chan[eChannel_nr1].time ) {
-            g_cfg.chan[eChannel_nr2].time = g_cfg.chan[eChannel_nr1].time;
+          if (channel_nr == eChannel_nr1) {
+            g_cfg.chan[channel_nr].time = range(select_value, MENU_TIM_ETS_VALUE, MENU_TIM_100MS_VALUE);
+          } else {
+            //fast acquisition-mode is only selectable on channel1
+            g_cfg.chan[channel_nr].time = range(select_value, MENU_TIM_50US_VALUE, MENU_TIM_100MS_VALUE);
           }
+          _check_time_limits();
           set_counter_defaults();
         } //end ATOMIC_BLOCK()
       }
@@ -534,7 +638,7 @@ void CMenu::_print_value_str(const uint8_t index, const channel_nr_t channel_nr,
       //only on channel1 available
       if (bchangevalue) {
         ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-          g_cfg.chan[channel_nr].trigger_mode = range(select_value, SET_TRIG_OFF, SET_TRIG_NORM_N);
+          g_cfg.chan[channel_nr].trigger_mode = range(select_value, SET_TRIG_OFF, SET_TRIG_SINGLE_N);
         }
       }
       this->_print_trigger_str(g_cfg.chan[channel_nr].trigger_mode);
@@ -543,7 +647,7 @@ void CMenu::_print_value_str(const uint8_t index, const channel_nr_t channel_nr,
       //only on channel1 available
       if (channel_nr == eChannel_nr1) {
         if (bchangevalue) {
-          g_cfg.chan[eChannel_nr1].trigger_level = range(select_value, 0, 1);
+          g_cfg.chan[eChannel_nr1].trigger_level = range(select_value, SET_TRIG_LEVEL_INTERN, SET_TRIG_LEVEL_SOFT2);
         }
         this->_print_triggerlevel_str(g_cfg.chan[eChannel_nr1].trigger_level);
       }
@@ -557,6 +661,187 @@ void CMenu::_print_value_str(const uint8_t index, const channel_nr_t channel_nr,
       _print_option_str(g_cfg.chan[channel_nr].option);
       }
     break;
+    case 8:
+      //only on channel1 available
+      if (channel_nr == eChannel_nr1) {
+        if (bchangevalue) {
+          g_cfg.chan[eChannel_nr1].pretrigger = range(select_value, SET_PRETRIG_0, SET_PRETRIG_75);
+        }
+        _print_pretrigger_str(g_cfg.chan[eChannel_nr1].pretrigger);
+      }
+    break;
+    case 9:
+      //only on channel1 available
+      if (channel_nr == eChannel_nr1) {
+        if (bchangevalue) {
+          ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            g_cfg.chan[eChannel_nr1].acquisition = range(select_value, SET_ACQ_NORMAL, SET_ACQ_DEEP);
+            _check_time_limits();
+            set_counter_defaults();
+          } //end ATOMIC_BLOCK()
+        }
+        _print_acquisition_str(g_cfg.chan[eChannel_nr1].acquisition);
+      }
+    break;
+    case 10:
+      //only on channel1 available
+      if (channel_nr == eChannel_nr1) {
+        if (bchangevalue) {
+          ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            g_cfg.chan[eChannel_nr1].average = range(select_value, SET_AVG_2, SET_AVG_64);
+            set_counter_defaults();
+          } //end ATOMIC_BLOCK()
+        }
+        this->print(1 << g_cfg.chan[eChannel_nr1].average);
+        this->print(F(" frames"));
+      }
+    break;
+    case 11:
+      //only on channel1 available, stretches both sample-times
+      if (channel_nr == eChannel_nr1) {
+        if (bchangevalue) {
+          ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            g_cfg.chan[eChannel_nr1].time_fine = range(select_value, 0, SET_FINE_MAX);
+            set_counter_defaults();
+          } //end ATOMIC_BLOCK()
+        }
+        uint32_t interval = sample_interval(eChannel_nr1);
+        if (interval == 0) {
+          this->_print_time_str(g_cfg.chan[eChannel_nr1].time);
+        } else {
+          this->_print_interval(interval, false);
+        }
+      }
+    break;
+    case 12:
+      //only on channel1 available
+      if (channel_nr == eChannel_nr1) {
+        if (bchangevalue) {
+          g_cfg.chan[eChannel_nr1].period_lock = range(select_value, SET_LOCK_OFF, SET_LOCK_4);
+        }
+        if (g_cfg.chan[eChannel_nr1].period_lock == SET_LOCK_OFF) {
+          this->print(F("Off"));
+        } else {
+          this->print(1 << (g_cfg.chan[eChannel_nr1].period_lock - 1));
+          this->print(F("  "));
+        }
+      }
+    break;
+    case 13:
+      //only on channel1 available, 10bit-value of the level
+      if (channel_nr == eChannel_nr1) {
+        if (bchangevalue) {
+          g_cfg.chan[eChannel_nr1].trigger_sw_level = (int8_t)range(select_value, -127, 126);
+        }
+        this->print(SWTRIG_MID + SWTRIG_STEP * g_cfg.chan[eChannel_nr1].trigger_sw_level);
+      }
+    break;
+    case 14:
+      //only on channel1 available, 10bit-value of the hysteresis
+      if (channel_nr == eChannel_nr1) {
+        if (bchangevalue) {
+          g_cfg.chan[eChannel_nr1].trigger_hyst = range(select_value, 0, SET_TRIG_HYST_MAX);
+        }
+        this->print(SWTRIG_STEP * g_cfg.chan[eChannel_nr1].trigger_hyst);
+      }
+    break;
+    case 15:
+      //only on channel1 available, the value keeps in its new range
+      if (channel_nr == eChannel_nr1) {
+        if (bchangevalue) {
+          g_cfg.chan[eChannel_nr1].holdoff_mode = range(select_value, SET_HOLDOFF_OFF, SET_HOLDOFF_EDGES);
+          if (g_cfg.chan[eChannel_nr1].holdoff_mode == SET_HOLDOFF_TIME) {
+            g_cfg.chan[eChannel_nr1].holdoff = range(g_cfg.chan[eChannel_nr1].holdoff, 0, SET_TRIG_TIMES - 1);
+          } else {
+            g_cfg.chan[eChannel_nr1].holdoff = range(g_cfg.chan[eChannel_nr1].holdoff, 1, SET_HOLDOFF_EDGES_MAX);
+          }
+        }
+        switch (g_cfg.chan[eChannel_nr1].holdoff_mode) {
+          case SET_HOLDOFF_TIME :
+            this->print(F("Time "));
+          break;
+          case SET_HOLDOFF_EDGES :
+            this->print(F("Edges"));
+          break;
+          default:
+            this->print(F("Off  "));
+          break;
+        }
+      }
+    break;
+    case 16:
+      //only on channel1 available, holdoff-time or number of edges
+      if (channel_nr == eChannel_nr1) {
+        if (g_cfg.chan[eChannel_nr1].holdoff_mode == SET_HOLDOFF_TIME) {
+          if (bchangevalue) {
+            g_cfg.chan[eChannel_nr1].holdoff = range(select_value, 0, SET_TRIG_TIMES - 1);
+          }
+          this->_print_interval(10UL * sample_trigger_usec(g_cfg.chan[eChannel_nr1].holdoff), false);
+        } else if (g_cfg.chan[eChannel_nr1].holdoff_mode == SET_HOLDOFF_EDGES) {
+          if (bchangevalue) {
+            g_cfg.chan[eChannel_nr1].holdoff = range(select_value, 1, SET_HOLDOFF_EDGES_MAX);
+          }
+          this->print(g_cfg.chan[eChannel_nr1].holdoff);
+          this->print(F("  "));
+        } else {
+          this->print(F("---"));
+        }
+      }
+    break;
+    case 17:
+      //only on channel1 available
+      if (channel_nr == eChannel_nr1) {
+        if (bchangevalue) {
+          g_cfg.chan[eChannel_nr1].trigger_qual = range(select_value, SET_QUAL_EDGE, SET_QUAL_DROPOUT);
+        }
+        switch (g_cfg.chan[eChannel_nr1].trigger_qual) {
+          case SET_QUAL_WIDER :
+            this->print(F("Wider  "));
+          break;
+          case SET_QUAL_NARROWER :
+            this->print(F("Narrow "));
+          break;
+          case SET_QUAL_DROPOUT :
+            this->print(F("Dropout"));
+          break;
+          default:
+            this->print(F("Edge   "));
+          break;
+        }
+      }
+    break;
+    case 18:
+      //only on channel1 available, pulse-width or dropout-time
+      if (channel_nr == eChannel_nr1) {
+        if (bchangevalue) {
+          g_cfg.chan[eChannel_nr1].qual_time = range(select_value, 0, SET_TRIG_TIMES - 1);
+        }
+        this->_print_interval(10UL * sample_trigger_usec(g_cfg.chan[eChannel_nr1].qual_time), false);
+      }
+    break;
+    case 19:
+      //only on channel1 available, every Nth trigger-edge
+      if (channel_nr == eChannel_nr1) {
+        if (bchangevalue) {
+          g_cfg.chan[eChannel_nr1].trigger_div = range(select_value, 1, SET_TRIG_DIV_MAX);
+        }
+        this->print(g_cfg.chan[eChannel_nr1].trigger_div);
+        this->print(F("  "));
+      }
+    break;
+    case 20:
+      //only on channel1 available, reset-pulse on channel2
+      if (channel_nr == eChannel_nr1) {
+        if (bchangevalue) {
+          g_cfg.chan[eChannel_nr1].div_reset = range(select_value, SET_OFF, SET_ON);
+        }
+        if (g_cfg.chan[eChannel_nr1].div_reset == SET_ON) {
+          this->print(F("Ch2"));
+        } else {
+          this->print(F("Off"));
+        }
+      }
+    break;
     default:
     break;
   }
@@ -634,7 +919,102 @@ void CMenu::_print_row_str(const uint8_t index, const channel_nr_t channel_nr) {
       }
     break;
     case 8:
-      /* nothing to do */
+      //pre-trigger select only on channel1
+      if(channel_nr == eChannel_nr1) {
+        this->print(STR_MENU_PRETRIG);
+        this->_print_value_str(index, channel_nr, g_cfg.chan[eChannel_nr1].pretrigger);
+      }
+    break;
+    case 9:
+      //acquisition-mode select only on channel1
+      if(channel_nr == eChannel_nr1) {
+        this->print(STR_MENU_ACQUIRE);
+        this->_print_value_str(index, channel_nr, g_cfg.chan[eChannel_nr1].acquisition);
+      }
+    break;
+    case 10:
+      //frame averaging select only on channel1
+      if(channel_nr == eChannel_nr1) {
+        this->print(STR_MENU_AVERAGE);
+        this->_print_value_str(index, channel_nr, g_cfg.chan[eChannel_nr1].average);
+      }
+    break;
+    case 11:
+      //fine sample-time select only on channel1
+      if(channel_nr == eChannel_nr1) {
+        this->print(STR_MENU_FINE);
+        this->_print_value_str(index, channel_nr, g_cfg.chan[eChannel_nr1].time_fine);
+      }
+    break;
+    case 12:
+      //period-locked display select only on channel1
+      if(channel_nr == eChannel_nr1) {
+        this->print(STR_MENU_PERIODS);
+        this->_print_value_str(index, channel_nr, g_cfg.chan[eChannel_nr1].period_lock);
+      }
+    break;
+    case 13:
+      //software trigger-level select only on channel1
+      if(channel_nr == eChannel_nr1) {
+        this->print(STR_MENU_SW_LEVEL);
+        this->_print_value_str(index, channel_nr, g_cfg.chan[eChannel_nr1].trigger_sw_level);
+      }
+    break;
+    case 14:
+      //software trigger-hysteresis select only on channel1
+      if(channel_nr == eChannel_nr1) {
+        this->print(STR_MENU_SW_HYST);
+        this->_print_value_str(index, channel_nr, g_cfg.chan[eChannel_nr1].trigger_hyst);
+      }
+    break;
+    case 15:
+      //trigger-holdoff select only on channel1
+      if(channel_nr == eChannel_nr1) {
+        this->print(STR_MENU_HOLDOFF);
+        this->_print_value_str(index, channel_nr, g_cfg.chan[eChannel_nr1].holdoff_mode);
+      }
+    break;
+    case 16:
+      //trigger-holdoff value only on channel1
+      if(channel_nr == eChannel_nr1) {
+        this->print(STR_MENU_HOLD_VALUE);
+        this->_print_value_str(index, channel_nr, g_cfg.chan[eChannel_nr1].holdoff);
+      }
+    break;
+    case 17:
+      //trigger-qualifier select only on channel1
+      if(channel_nr == eChannel_nr1) {
+        this->print(STR_MENU_QUALIFIER);
+        this->_print_value_str(index, channel_nr, g_cfg.chan[eChannel_nr1].trigger_qual);
+      }
+    break;
+    case 18:
+      //trigger-qualifier time only on channel1
+      if(channel_nr == eChannel_nr1) {
+        this->print(STR_MENU_QUAL_TIME);
+        this->_print_value_str(index, channel_nr, g_cfg.chan[eChannel_nr1].qual_time);
+      }
+    break;
+    case 19:
+      //trigger-divider select only on channel1
+      if(channel_nr == eChannel_nr1) {
+        this->print(STR_MENU_DIVIDER);
+        this->_print_value_str(index, channel_nr, g_cfg.chan[eChannel_nr1].trigger_div);
+      }
+    break;
+    case 20:
+      //trigger-divider reset only on channel1
+      if(channel_nr == eChannel_nr1) {
+        this->print(STR_MENU_DIV_RESET);
+        this->_print_value_str(index, channel_nr, g_cfg.chan[eChannel_nr1].div_reset);
+      }
+    break;
+    case MENU_ROW_AUTOSET:
+      //autoset only on channel1
+      if(channel_nr == eChannel_nr1) {
+        this->print(STR_MENU_AUTOSET);
+        this->print(F("Push"));
+      }
     break;
     default:
     break;
@@ -643,10 +1023,27 @@ void CMenu::_print_row_str(const uint8_t index, const channel_nr_t channel_nr) {
 
 void CMenu::_defaultMenu(void) {
   uint8_t x1=_menuctrl.cursor_x+39;
-  uint8_t y=_index2_ypixel(_menuctrl.rowindex);
+  uint8_t y;
+  //the roll-draw has to start again with a complete draw
+  _roll_active = false;
+  //row 1 stays on top, the other rows are scrolled to the selected one
+  if (_menuctrl.rowindex == 1) {
+    _menuctrl.rowoffset = 0;
+  } else if (_menuctrl.rowindex < (_menuctrl.rowoffset + 2)) {
+    _menuctrl.rowoffset = _menuctrl.rowindex - 2;
+  } else if (_menuctrl.rowindex > (_menuctrl.rowoffset + MENU_ROWS_VISIBLE)) {
+    _menuctrl.rowoffset = _menuctrl.rowindex - MENU_ROWS_VISIBLE;
+  }
+  if (_menuctrl.rowindex == 1) {
+    y=_index2_ypixel(1);
+  } else {
+    y=_index2_ypixel(_menuctrl.rowindex - _menuctrl.rowoffset);
+  }
   clearDisplay();
   setTextSize(0);
-  for (uint8_t irow=1; irow <= 8; irow++) {
+  _print_row_str(1, g_cfg.selected_channel);
+  this->println();
+  for (uint8_t irow=2+_menuctrl.rowoffset; irow <= MENU_ROWS_VISIBLE+_menuctrl.rowoffset; irow++) {
     _print_row_str(irow, g_cfg.selected_channel);
     this->println();
   }
@@ -655,6 +1052,7 @@ void CMenu::_defaultMenu(void) {
 }
 
 void CMenu::_saveMenu(bool save_data) {
+  _roll_active = false;
   clearDisplay();
   setTextSize(0);
   setCursor(10, 16);
@@ -677,8 +1075,92 @@ void CMenu::_saveMenu(bool save_data) {
   display();
 }
 
+/*!
+ *
+ * name: _print_interval
+ * @brief  prints a sample-interval with its unit, 3 significant digits
+ *         or compact with 3 characters like _print_time_str().
+ * @param  uint32_t interval  sample-interval in 0.1usec
+ * @param  bool compact
+ * @return none
+ *
+ */
+void CMenu::_print_interval(uint32_t interval, const bool compact) {
+  //fixed point with 2 decimals: 0.01usec or 0.01msec
+  const __FlashStringHelper * unit = STR_MENU_USEC;
+  if (interval >= 10000UL) {
+    interval /= 100;
+    unit = STR_MENU_MSEC;
+  } else {
+    interval *= 10;
+  }
+  uint16_t value = (uint16_t)interval;
+  if (value < 1000) {
+    this->print(value / 100);
+    this->print('.');
+    this->print((value / 10) % 10);
+    if (compact == false) {
+      this->print(value % 10);
+    }
+  } else if (value < 10000) {
+    if (compact) {
+      this->print(' ');
+    }
+    this->print(value / 100);
+    if (compact == false) {
+      this->print('.');
+      this->print((value / 10) % 10);
+    }
+  } else {
+    this->print(value / 100);
+  }
+  this->print(unit);
+}
+
+/*!
+ *
+ * name: _print_channel_time
+ * @brief  prints the sample-time of a channel, the real interval on
+ *         fine sample-times.
+ * @param  channel_nr_t channel_nr
+ * @return none
+ *
+ */
+void CMenu::_print_channel_time(const channel_nr_t channel_nr) {
+  uint32_t interval = 0;
+  if (g_cfg.chan[eChannel_nr1].time_fine != 0) {
+    interval = sample_interval(channel_nr);
+  }
+  if (interval == 0) {
+    this->_print_time_str(g_cfg.chan[channel_nr].time);
+  } else {
+    this->_print_interval(interval, true);
+  }
+}
+
 void CMenu::_print_time_str(const uint8_t timevalue) {
   switch (timevalue) {
+    case MENU_TIM_ETS_VALUE:
+      this->print(STR_MENU_TIM_ETS);
+      this->print(STR_MENU_USEC);
+    break;
+    case MENU_TIM_BURST_VALUE:
+      //burst on dual-channel: sampled alternating
+      if (g_cfg.chan[eChannel_nr2].status == SET_ON) {
+        this->print(STR_MENU_TIM_BURST2);
+      } else {
+        this->print(STR_MENU_TIM_BURST);
+      }
+      this->print(STR_MENU_USEC);
+    break;
+    case MENU_TIM_10US_VALUE:
+      this->print(STR_MENU_TIM_10US);
+      this->print(STR_MENU_USEC);
+    break;
+    case MENU_TIM_20US_VALUE:
+      this->print(STR_MENU_TIM_20US);
+      this->print(STR_MENU_USEC);
+    break;
     case MENU_TIM_50US_VALUE:
       this->print(STR_MENU_TIM_50US);
       this->print(STR_MENU_USEC);
@@ -745,6 +1227,12 @@ void CMenu::_print_trigger_str(const uint8_t triggervalue) {
     case SET_TRIG_NORM_N :
       this->print(F("Norm -"));
     break;
+    case SET_TRIG_SINGLE_P :
+      this->print(F("Sngl +"));
+    break;
+    case SET_TRIG_SINGLE_N :
+      this->print(F("Sngl -"));
+    break;
     default:
     break;
   }
@@ -758,6 +1246,12 @@ void CMenu::_print_triggerlevel_str(const uint8_t triggerlevel) {
     case SET_TRIG_LEVEL_EXTERN :
       this->print(F("Ext.Ref"));
     break;
+    case SET_TRIG_LEVEL_SOFT1 :
+      this->print(F("Soft 1 "));
+    break;
+    case SET_TRIG_LEVEL_SOFT2 :
+      this->print(F("Soft 2 "));
+    break;
     default:
     break;
   }
@@ -785,6 +1279,53 @@ void CMenu::_print_option_str(const uint8_t optionvalue) {
   }
 }
 
+void CMenu::_print_pretrigger_str(const uint8_t pretrigger) {
+  switch (pretrigger) {
+    case SET_PRETRIG_0:
+      this->print(F(" 0%"));
+    break;
+    case SET_PRETRIG_25:
+      this->print(F("25%"));
+    break;
+    case SET_PRETRIG_50:
+      this->print(F("50%"));
+    break;
+    case SET_PRETRIG_75:
+      this->print(F("75%"));
+    break;
+    default:
+    break;
+  }
+}
+
+void CMenu::_print_acquisition_str(const uint8_t acquisition) {
+  switch (acquisition) {
+    case SET_ACQ_NORMAL:
+      this->print(F("Normal"));
+    break;
+    case SET_ACQ_HIRES:
+      this->print(F("HiRes "));
+    break;
+    case SET_ACQ_PEAK:
+      this->print(F("Peak  "));
+    break;
+    case SET_ACQ_ROLL:
+      this->print(F("Roll  "));
+    break;
+    case SET_ACQ_SEGMENT:
+      this->print(F("Segment"));
+    break;
+    case SET_ACQ_AVERAGE:
+      this->print(F("Average"));
+    break;
+    case SET_ACQ_DEEP:
+      this->print(F("Deep  "));
+    break;
+    default:
+    break;
+  }
+}
+
 void CMenu::_print_onoff_str(const uint8_t onoffvalue) {
   switch (onoffvalue) {
     case 0:
@@ -809,7 +1350,9 @@ uint8_t CMenu::_index2_ypixel(const uint8_t index) {
 /*!
  *
  * name: _draw_channels
- * @brief  drawing sampled data to the display.
+ * @brief  drawing sampled data to the display. The frame is rendered
+ *         completely into the display-buffer and transferred once,
+ *         its duration is shown as frame-time (F:).
  * @param  none
  * @return none
  *
@@ -828,7 +1371,30 @@ void CMenu::_draw_channels(void) {
 
   //get frequency-value 10 times higher
   this->_read_frequency(_frequ_meas_value10, 10);
-  if (_update_draw_request()) {
+  this->_update_statistics();
+  this->_auto_range();
+  //frame averaging: every new triggered frame is averaged
+  if ((sample_acquisition() == SET_ACQ_AVERAGE) &&
+      (g_cfg.chan[eChannel_nr1].trigger_mode != SET_OFF) &&
+      g_cfg.chan[eChannel_nr1].sample_draw)
+  {
+    _average_frames = sample_average_frame();
+  }
+  if ((sample_acquisition() == SET_ACQ_ROLL) &&
+      (g_cfg.chan[eChannel_nr1].option != SET_OPT_FREQU) &&
+      (g_cfg.chan[eChannel_nr1].option != SET_OPT_TUNING))
+  {
+    _draw_roll();
+  } else if (_update_draw_request()) {
+    _roll_active = false;
+    //burst-capture on free running draws, triggered ones are done
+    //  in the analog comparator interrupt
+    if ((g_cfg.chan[eChannel_nr1].time == MENU_TIM_BURST_VALUE) &&
+        (g_cfg.chan[eChannel_nr1].trigger_mode == SET_OFF))
+    {
+      sample_burst();
+    }
+    unsigned long int frame_start = micros();
     this->clearDisplay();
     if ((g_cfg.chan[eChannel_nr1].option == SET_OPT_FREQU) ||
         (g_cfg.chan[eChannel_nr1].option == SET_OPT_TUNING))
@@ -836,13 +1402,55 @@ void CMenu::_draw_channels(void) {
       _show_measurement();
     } else {
       //draw current sample-time to display
-      this->setCursor(86, 0);
-      this->print(F("1:"));
-      this->_print_time_str(g_cfg.chan[eChannel_nr1].time);
-      if (g_cfg.chan[eChannel_nr2].status == 1) {
-        this->setCursor(86, 32);
-        this->print(F("2:"));
-        this->_print_time_str(g_cfg.chan[eChannel_nr2].time);
+      _draw_time_header();
+      //mark the trigger-position on pre-trigger, deep memory marks
+      //  it within the zoomed view
+      if ((g_cfg.chan[eChannel_nr1].trigger_mode != SET_OFF) &&
+          (g_cfg.chan[eChannel_nr1].pretrigger != SET_PRETRIG_0) &&
+          (sample_acquisition() != SET_ACQ_DEEP))
+      {
+        int16_t x_trigger = g_cfg.chan[eChannel_nr1].pretrigger * (SAMPLE_DATA_SIZE/4);
+        this->drawLine(x_trigger, 0, x_trigger, 3, SH110X_WHITE);
+      }
+      //mark the software trigger-level on the right border
+      if ((g_cfg.chan[eChannel_nr1].trigger_mode != SET_OFF) &&
+          (g_cfg.chan[eChannel_nr1].trigger_level >= SET_TRIG_LEVEL_SOFT1))
+      {
+        channel_nr_t trigger_channel = (g_cfg.chan[eChannel_nr1].trigger_level == SET_TRIG_LEVEL_SOFT1) ? eChannel_nr1 : eChannel_nr2;
+        int16_t y_level = _sample_ypixel((SWTRIG_MID + SWTRIG_STEP * g_cfg.chan[eChannel_nr1].trigger_sw_level) / 16, trigger_channel);
+        this->drawLine(this->_x_border - 3, y_level, this->_x_border, y_level, SH110X_WHITE);
+      }
+      //single-shot: waiting for the trigger or kept until re-armed
+      if ((g_cfg.chan[eChannel_nr1].trigger_mode == SET_TRIG_SINGLE_P) ||
+          (g_cfg.chan[eChannel_nr1].trigger_mode == SET_TRIG_SINGLE_N))
+      {
+        this->setCursor(86, 24);
+        if (sample_single_armed()) {
+          this->print(F("Armed"));
+        } else {
+          this->print(F("Stop"));
+        }
+      }
+      //frame-time of the last draw, segmented and deep memory are
+      //  showing their view in this row
+      if ((sample_acquisition() != SET_ACQ_SEGMENT) &&
+          (sample_acquisition() != SET_ACQ_DEEP))
+      {
+        this->setCursor(86, 8);
+        this->print(F("F:"));
+        this->_print_interval(10UL * _frame_usec, true);
+      }
+      //show acquisition-statistics on triggered draws
+      if (g_cfg.chan[eChannel_nr1].trigger_mode != SET_OFF) {
+        this->setCursor(86, 40);
+        this->print(F("T:"));
+        this->print(_triggers_per_sec);
+        this->setCursor(86, 48);
+        this->print(F("W:"));
+        this->print(_waveforms_per_sec);
+        this->setCursor(86, 56);
+        this->print(F("M:"));
+        this->print(_missed_per_sec);
       }
       //check for option: plugged in on channel2
       if (g_cfg.chan[eChannel_nr1].option == SET_OPT_DUAL_PLUGGED) {
@@ -853,39 +1461,89 @@ void CMenu::_draw_channels(void) {
         }
       }
 
+      //front-buffers are swapped by the ADC-interrupt only after drawing
+      const sample_t * psample1 = pchannel1;
+      const sample_t * psample2 = pchannel2;
+      bool draw_ch1 = g_cfg.chan[eChannel_nr1].sample_draw;
+      bool draw_ch2 = (g_cfg.chan[eChannel_nr2].status == 1) && (psample2 != NULL);
+      //frame averaging: averaged frame on triggered draws, channel2 is off
+      if ((sample_acquisition() == SET_ACQ_AVERAGE) &&
+          (g_cfg.chan[eChannel_nr1].trigger_mode != SET_OFF))
+      {
+        if (draw_ch1) {
+          _draw_average();
+        }
+        draw_ch1 = false;
+      }
+      //segmented memory: selected segments, channel2 is off
+      if (sample_acquisition() == SET_ACQ_SEGMENT) {
+        if (draw_ch1) {
+          _draw_segments();
+        }
+        draw_ch1 = false;
+      }
+      //deep memory: decimated to the display-width, channel2 is off
+      if (sample_acquisition() == SET_ACQ_DEEP) {
+        if (draw_ch1) {
+          _draw_deep();
+        }
+        draw_ch1 = false;
+      }
+      //peak-detect: min/max pairs are drawn as vertical bars
+      if (sample_acquisition() == SET_ACQ_PEAK) {
+        if (draw_ch1) {
+          _draw_peak(psample1, eChannel_nr1);
+        }
+        if (draw_ch2) {
+          _draw_peak(psample2, eChannel_nr2);
+        }
+        draw_ch1 = false;
+        draw_ch2 = false;
+      }
+      //period-locked display: resampled from the trigger-position
+      uint16_t step1 = 0, step2 = 0;
+      if ((draw_ch1 || draw_ch2) &&
+          (g_cfg.chan[eChannel_nr1].period_lock != SET_LOCK_OFF))
+      {
+        uint8_t periods;
+        step1 = _period_step(periods);
+        uint32_t interval2 = sample_interval(eChannel_nr2);
+        if ((step1 != 0) && (interval2 != 0)) {
+          //channel2 is drawn on the same time-axis as channel1
+          step2 = (uint16_t)min((uint32_t)step1 * sample_interval(eChannel_nr1) / interval2, (uint32_t)0xFFFF);
+        }
+        this->setCursor(86, 16);
+        this->print(F("P:"));
+        if (step1 != 0) {
+          this->print(periods);
+        } else {
+          this->print(F("-"));
+        }
+      }
+      //sub-sample trigger-position, the frames are shifted to it
+      int16_t shift1 = draw_ch1 ? _trigger_shift(psample1, eChannel_nr1) : 0;
+      int16_t shift2 = draw_ch2 ? _trigger_shift(psample2, eChannel_nr2) : 0;
       for (uint8_t x = 0; x < this->_x_border - 1; x++) {
         //draw channel1
           //draw channel1-samples only if enabled (triggered)
-        if (g_cfg.chan[eChannel_nr1].sample_draw) {
-          y0_1 = this->_y_border - (int16_t)channel1.data[x];
-          y1_1 = this->_y_border - (int16_t)channel1.data[(x+1)];
-          if (g_cfg.chan[eChannel_nr2].status == SET_ON) {
-            //set amplitude/2, if both draws are visible
-            y0_1 = y0_1/2;
-            y1_1 = y1_1/2;
-          }
-          y0_1 -= g_cfg.chan[eChannel_nr1].offset;
-          y1_1 -= g_cfg.chan[eChannel_nr1].offset;
-          //check range, max +-1 line out of boarder for best drawing
-          y0_1 = range(y0_1, -1, this->_y_border+1);
-          y1_1 = range(y1_1, -1, this->_y_border+1);
+        if (draw_ch1) {
+          y0_1 = _sample_ypixel(_column_sample(psample1, x, step1, shift1), eChannel_nr1);
+          y1_1 = _sample_ypixel(_column_sample(psample1, x+1, step1, shift1), eChannel_nr1);
           this->drawLine((int16_t)x, y0_1, (int16_t)(x+1), y1_1, SH110X_WHITE); //left to right
         }
 
         //draw channel2-samples only if second draw is enabled
-        if ((g_cfg.chan[eChannel_nr2].status == 1) && pchannel2 != NULL)
+        if (draw_ch2)
         {
-          //set amplitude/2 and add offset
-          y0_2 = (this->_y_border - (int16_t)pchannel2->data[x])/2 + 31 - g_cfg.chan[eChannel_nr2].offset;
-          y1_2 = (this->_y_border - (int16_t)pchannel2->data[(x+1)])/2 + 31 - g_cfg.chan[eChannel_nr2].offset;
-          //check range, max +-1 line out of boarder for best drawing
-          y0_2 = range(y0_2, -1, this->_y_border+1);
-          y1_2 = range(y1_2, -1, this->_y_border+1);
+          y0_2 = _sample_ypixel(_column_sample(psample2, x, step2, shift2), eChannel_nr2);
+          y1_2 = _sample_ypixel(_column_sample(psample2, x+1, step2, shift2), eChannel_nr2);
           this->drawLine((int16_t)x, y0_2, (int16_t)(x+1), y1_2, SH110X_WHITE); //left to right
         }
-        this->display();
       }
     }
+    //the complete frame is rendered, transfer it once
+    this->display();
+    _frame_usec = micros() - frame_start;
   } //end if (_update_draw_request()
 
   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
@@ -893,7 +1551,15 @@ void CMenu::_draw_channels(void) {
     if (g_cfg.chan[eChannel_nr1].trigger_mode == SET_OFF) {
       g_cfg.chan[eChannel_nr1].sample_draw = true;
       g_cfg.chan[eChannel_nr1].sample_start= true;
-    } else {
+    } else if ((g_cfg.chan[eChannel_nr1].trigger_mode == SET_TRIG_SINGLE_P) ||
+               (g_cfg.chan[eChannel_nr1].trigger_mode == SET_TRIG_SINGLE_N)) {
+      //single-shot: the captured frame is kept until re-armed
+      if (sample_single_armed()) {
+        g_cfg.chan[eChannel_nr1].sample_draw = false;
+      }
+    } else if (((sample_acquisition() != SET_ACQ_SEGMENT) &&
+                (sample_acquisition() != SET_ACQ_DEEP)) || (_draw_view == 0)) {
+      //captured segments and deep memory are kept on review
       g_cfg.chan[eChannel_nr1].sample_draw = false;
     }
     //channel2
@@ -909,6 +1575,433 @@ void CMenu::_draw_channels(void) {
 //  PINC = (1<<PINC5);
 }
 
+/*!
+ *
+ * name: _draw_time_header
+ * @brief  draws the current sample-times to the display.
+ * @param  none
+ * @return none
+ *
+ */
+void CMenu::_draw_time_header(void) {
+  this->setCursor(86, 0);
+  this->print(F("1:"));
+  this->_print_channel_time(eChannel_nr1);
+  if (g_cfg.chan[eChannel_nr2].status == 1) {
+    this->setCursor(86, 32);
+    this->print(F("2:"));
+    this->_print_channel_time(eChannel_nr2);
+  }
+}
+
+/*!
+ *
+ * name: _draw_roll
+ * @brief  roll-mode: the newest sample is drawn on the right border,
+ *         as soon as it is available. The first draw is complete,
+ *         afterwards the display-buffer is shifted left by the number
+ *         of new samples and only the new columns are drawn.
+ * @param  none
+ * @return none
+ *
+ */
+void CMenu::_draw_roll(void) {
+  const sample_t * psample1 = pchannel1;
+  const sample_t * psample2 = pchannel2;
+  uint8_t index1, index2;
+  uint8_t first;
+  uint8_t ch2_status = g_cfg.chan[eChannel_nr2].status;
+
+  //check for option: plugged in on channel2, redraw on changes
+  if (g_cfg.chan[eChannel_nr1].option == SET_OPT_DUAL_PLUGGED) {
+    g_cfg.chan[eChannel_nr2].status = (_is_plugged_in()) ? 1 : 0;
+    if (g_cfg.chan[eChannel_nr2].status != ch2_status) {
+      _roll_active = false;
+    }
+  }
+  bool draw_ch2 = (g_cfg.chan[eChannel_nr2].status == 1) && (psample2 != NULL);
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    index1 = psample1->index;
+    index2 = (draw_ch2) ? psample2->index : index1;
+  }
+  if (index1 != index2) {
+    //channel2 conversion is running, draw on next call
+    return;
+  }
+  if (_roll_active) {
+    uint8_t count = (index1 - _roll_index) & SAMPLE_INDEX_MASK;
+    if (count == 0) {
+      return;
+    }
+    //shift the display-buffer left, one byte per column and 8 lines
+    uint8_t * pbuffer = this->getBuffer();
+    for (uint8_t page = 0; page < (this->height()/8); page++) {
+      memmove(pbuffer, pbuffer + count, this->width() - count);
+      memset(pbuffer + this->width() - count, 0, count);
+      pbuffer += this->width();
+    }
+    //first line starts at the last sample already drawn
+    first = this->_x_border - count;
+  } else {
+    this->clearDisplay();
+    first = 0;
+    _roll_active = true;
+  }
+  //oldest sample on the left, column x shows sample (index + x)
+  for (uint8_t x = first; x < this->_x_border; x++) {
+    uint8_t pos = (uint8_t)(index1 + x) & SAMPLE_INDEX_MASK;
+    uint8_t next = (uint8_t)(pos + 1) & SAMPLE_INDEX_MASK;
+    this->drawLine((int16_t)x, _sample_ypixel(psample1->data[pos], eChannel_nr1),
+                   (int16_t)(x+1), _sample_ypixel(psample1->data[next], eChannel_nr1), SH110X_WHITE);
+    if (draw_ch2) {
+      this->drawLine((int16_t)x, _sample_ypixel(psample2->data[pos], eChannel_nr2),
+                     (int16_t)(x+1), _sample_ypixel(psample2->data[next], eChannel_nr2), SH110X_WHITE);
+    }
+  }
+  //shifted sample-times are renewed
+  this->fillRect(86, 0, this->width() - 86, 8, SH110X_BLACK);
+  if (draw_ch2) {
+    this->fillRect(86, 32, this->width() - 86, 8, SH110X_BLACK);
+  }
+  _draw_time_header();
+  _roll_index = index1;
+  this->display();
+}
+
+/*!
+ *
+ * name: _draw_samples
+ * @brief  draws the sample-data of one frame as line.
+ * @param  const sample_t * psample  sample-data
+ * @param  channel_nr_t channel_nr
+ * @return none
+ *
+ */
+void CMenu::_draw_samples(const sample_t * psample, const channel_nr_t channel_nr) {
+  for (uint8_t x = 0; x < this->_x_border - 1; x++) {
+    this->drawLine((int16_t)x, _sample_ypixel(sample_at(psample, x), channel_nr),
+                   (int16_t)(x+1), _sample_ypixel(sample_at(psample, x+1), channel_nr), SH110X_WHITE);
+  }
+}
+
+/*!
+ *
+ * name: _period_step
+ * @brief  period-locked display: samples per column in 1/256, so the
+ *         display-width shows the selected number of periods of the
+ *         measured channel1 frequency, starting at the trigger-position.
+ *         The periods are halved, until they fit into the frame of
+ *         channel1.
+ * @param  uint8_t & periods  number of periods shown
+ * @return uint16_t  channel1 samples per column in 1/256, 0 if not locked
+ *
+ */
+uint16_t CMenu::_period_step(uint8_t & periods) {
+  uint32_t interval = sample_interval(eChannel_nr1);
+  periods = 0;
+  if ((g_cfg.chan[eChannel_nr1].trigger_mode == SET_OFF) ||
+      (_frequ_meas_value10 <= 0L) || (interval == 0)) {
+    return 0;
+  }
+  //all columns have to be within the frame behind the trigger-position
+  uint8_t pre_samples = g_cfg.chan[eChannel_nr1].pretrigger * (SAMPLE_DATA_SIZE/4);
+  double max_step = (double)(SAMPLE_DATA_SIZE - 1 - pre_samples) * 256.0 / (this->_x_border - 1);
+  //period in 0.1usec is 1e8/frequency10, spread over the display-width
+  double step = 2.0e8 / (_frequ_meas_value10 * interval) * 128.0 / this->_x_border;
+  for (periods = 1 << (g_cfg.chan[eChannel_nr1].period_lock - 1); periods > 0; periods /= 2) {
+    if ((step * periods) < max_step) {
+      return (uint16_t)(step * periods);
+    }
+  }
+  return 0;
+}
+
+/*!
+ *
+ * name: _trigger_shift
+ * @brief  sub-sample position of the trigger within a triggered frame:
+ *         the delay of the first post-trigger sample in timer1-clocks
+ *         scaled by the sample-interval. Burst and ETS are exact.
+ * @param  const sample_t * psample  sample-data
+ * @param  channel_nr_t channel_nr
+ * @return int16_t  shift in 1/256 samples
+ *
+ */
+int16_t CMenu::_trigger_shift(const sample_t * psample, const channel_nr_t channel_nr) {
+  uint32_t interval = sample_interval(channel_nr);
+  if ((g_cfg.chan[eChannel_nr1].trigger_mode == SET_OFF) || (interval == 0)) {
+    return 0;
+  }
+  //timer1-clock is 0.0625usec, the interval is in 0.1usec
+  int32_t shift = ((int32_t)psample->delay * 160L) / (int32_t)interval;
+  return (int16_t)range(shift, -256L, 256L);
+}
+
+/*!
+ *
+ * name: _column_sample
+ * @brief  sample-value of a display-column, linear interpolated on
+ *         the period-locked display and on the sub-sample shift.
+ * @param  const sample_t * psample  sample-data
+ * @param  uint8_t x  display-column
+ * @param  uint16_t step  samples per column in 1/256, 0:= one sample
+ * @param  int16_t shift  trigger-position in 1/256 samples
+ * @return uint8_t  sample-value
+ *
+ */
+uint8_t CMenu::_column_sample(const sample_t * psample, const uint8_t x, const uint16_t step, const int16_t shift) {
+  if ((step == 0) && (shift == 0)) {
+    return sample_at(psample, x);
+  }
+  int32_t pos = (step == 0) ? ((int32_t)x << 8) :
+                ((int32_t)(g_cfg.chan[eChannel_nr1].pretrigger * (SAMPLE_DATA_SIZE/4)) << 8) + (int32_t)x * step;
+  pos = range(pos - shift, 0L, (int32_t)(SAMPLE_DATA_SIZE - 1) << 8);
+  uint8_t index = pos >> 8;
+  uint8_t value = sample_at(psample, index);
+  int16_t delta = (int16_t)sample_at(psample, index + 1) - value;
+  return value + (int8_t)((delta * (int16_t)(pos & 0xFF)) / 256);
+}
+
+/*!
+ *
+ * name: _draw_segments
+ * @brief  segmented memory: draws the segment selected for review or
+ *         all segments together, while capture is running.
+ * @param  none
+ * @return none
+ *
+ */
+void CMenu::_draw_segments(void) {
+  uint8_t segments = sample_segments();
+  this->setCursor(86, 8);
+  this->print(F("S:"));
+  if (_draw_view == 0) {
+    this->print(F("Run"));
+  } else if (_draw_view > segments) {
+    this->print(F("All"));
+  } else {
+    this->print(_draw_view);
+    this->print(F("/"));
+    this->print(segments);
+  }
+  for (uint8_t n = 0; n < segments; n++) {
+    if ((_draw_view == 0) || (_draw_view > segments) || (_draw_view == (n+1))) {
+      _draw_samples(sample_segment(n), eChannel_nr1);
+    }
+  }
+}
+
+/*!
+ *
+ * name: _draw_average
+ * @brief  frame averaging: draws the averaged frame and the number of
+ *         averaged frames, until the selected number is reached.
+ * @param  none
+ * @return none
+ *
+ */
+void CMenu::_draw_average(void) {
+  uint8_t frames = 1 << g_cfg.chan[eChannel_nr1].average;
+  this->setCursor(86, 8);
+  this->print(F("A:"));
+  this->print(min(_average_frames, frames));
+  for (uint8_t x = 0; x < this->_x_border - 1; x++) {
+    this->drawLine((int16_t)x, _sample_ypixel(sample_average_at(x), eChannel_nr1),
+                   (int16_t)(x+1), _sample_ypixel(sample_average_at(x+1), eChannel_nr1), SH110X_WHITE);
+  }
+}
+
+/*!
+ *
+ * name: _deep_view
+ * @brief  deep memory: first sample and samples per column of the
+ *         selected view. Every zoom-level is panned in steps of a
+ *         quarter display-width.
+ * @param  uint16_t & pan   first sample of the view
+ * @param  uint8_t & step   samples per column
+ * @return none
+ *
+ */
+void CMenu::_deep_view(uint16_t & pan, uint8_t & step) {
+  uint8_t view = _draw_view;
+  step = DEEP_SAMPLES / SAMPLE_DATA_SIZE;
+  for (;;) {
+    uint8_t positions = 4 * (DEEP_SAMPLES / (step * SAMPLE_DATA_SIZE)) - 3;
+    if ((view < positions) || (step == 1)) {
+      break;
+    }
+    view -= positions;
+    step /= 2;
+  }
+  pan = view * (step * (SAMPLE_DATA_SIZE / 4));
+}
+
+/*!
+ *
+ * name: _draw_deep
+ * @brief  deep memory: draws the selected view, every column shows
+ *         min/max of its samples as vertical bar, joined to the
+ *         previous column. So nothing is lost by decimation.
+ * @param  none
+ * @return none
+ *
+ */
+void CMenu::_draw_deep(void) {
+  uint16_t pan;
+  uint8_t step;
+  uint8_t last_min = 0, last_max = 0;
+  _deep_view(pan, step);
+  this->setCursor(86, 8);
+  if (_draw_view == 0) {
+    this->print(F("D:Run"));
+  } else {
+    this->print(F("x"));
+    this->print(DEEP_SAMPLES / (step * SAMPLE_DATA_SIZE));
+    this->print(F(":"));
+    this->print(pan);
+  }
+  //trigger-position within the view
+  if ((g_cfg.chan[eChannel_nr1].trigger_mode != SET_OFF) &&
+      (g_cfg.chan[eChannel_nr1].pretrigger != SET_PRETRIG_0))
+  {
+    uint16_t trigger = g_cfg.chan[eChannel_nr1].pretrigger * (DEEP_SAMPLES/4);
+    if ((trigger >= pan) && ((trigger - pan) / step < this->_x_border)) {
+      int16_t x_trigger = (trigger - pan) / step;
+      this->drawLine(x_trigger, 0, x_trigger, 3, SH110X_WHITE);
+    }
+  }
+  for (uint8_t x = 0; x < this->_x_border; x++) {
+    uint8_t min_value = 0xFF, max_value = 0;
+    for (uint8_t n = 0; n < step; n++) {
+      uint8_t value = sample_deep_at(pan + x * step + n);
+      min_value = min(min_value, value);
+      max_value = max(max_value, value);
+    }
+    if (x > 0) {
+      //join to the previous column
+      uint8_t next_min = min_value;
+      min_value = min(min_value, last_max);
+      last_max = max_value;
+      max_value = max(max_value, last_min);
+      last_min = next_min;
+    } else {
+      last_min = min_value;
+      last_max = max_value;
+    }
+    this->drawLine((int16_t)x, _sample_ypixel(min_value, eChannel_nr1),
+                   (int16_t)x, _sample_ypixel(max_value, eChannel_nr1), SH110X_WHITE);
+  }
+}
+
+/*!
+ *
+ * name: _is_view_selectable
+ * @brief  segmented and deep memory: the encoder selects the view
+ *         in draw-mode instead of opening the menu.
+ * @param  none
+ * @return true, if the view is selected by the encoder
+ *
+ */
+bool CMenu::_is_view_selectable(void) {
+  return ((sample_acquisition() == SET_ACQ_SEGMENT) ||
+          (sample_acquisition() == SET_ACQ_DEEP));
+}
+
+/*!
+ *
+ * name: _select_draw_view
+ * @brief  the encoder selects the view in draw-mode.
+ *         segmented memory: capture or review of single or all segments.
+ *         deep memory: capture or review zoomed and panned.
+ *         Drawupdate() doesn't change it, the encoder-state is unchanged.
+ * @param  none
+ * @return none
+ *
+ */
+void CMenu::_select_draw_view(void) {
+  int8_t select_view = _draw_view;
+  int8_t max_view;
+  if (sample_acquisition() == SET_ACQ_SEGMENT) {
+    max_view = sample_segments() + 1;
+  } else if (sample_acquisition() == SET_ACQ_DEEP) {
+    max_view = DEEP_VIEWS - 1;
+  } else {
+    _draw_view = 0;
+    return;
+  }
+  if (_in_drawupdate) {
+    return;
+  }
+  if (this->rotaryencoder.down()) {
+    select_view++;
+  }
+  if (this->rotaryencoder.up()) {
+    select_view--;
+  }
+  select_view = range(select_view, 0, max_view);
+  if (select_view != _draw_view) {
+    _draw_view = select_view;
+    //draw the new selection at once
+    _drawupdateTimer = millis() - DRAWUPDATE_TIMEOUT - 1;
+  }
+}
+
+/*!
+ *
+ * name: _sample_ypixel
+ * @brief  display-line of a sample-value.
+ *         channel1 is drawn with amplitude/2, if both draws are visible,
+ *         channel2 always with amplitude/2 on the lower half.
+ * @param  uint8_t value  sample-value
+ * @param  channel_nr_t channel_nr
+ * @return int16_t  y-pixel, max +-1 line out of boarder for best drawing
+ *
+ */
+int16_t CMenu::_sample_ypixel(const uint8_t value, const channel_nr_t channel_nr) {
+  int16_t y = this->_y_border - (int16_t)value;
+  if (channel_nr == eChannel_nr1) {
+    if (g_cfg.chan[eChannel_nr2].status == SET_ON) {
+      y = y/2;
+    }
+    y -= g_cfg.chan[eChannel_nr1].offset;
+  } else {
+    y = y/2 + 31 - g_cfg.chan[eChannel_nr2].offset;
+  }
+  return range(y, -1, this->_y_border+1);
+}
+
+/*!
+ *
+ * name: _draw_peak
+ * @brief  draws the min/max sample-pairs of peak-detect acquisition
+ *         as vertical bars over two columns each. Every bar is extended
+ *         to the previous one, so steep edges stay a closed trace.
+ * @param  const sample_t * psample  sample-data
+ * @param  channel_nr_t channel_nr
+ * @return none
+ *
+ */
+void CMenu::_draw_peak(const sample_t * psample, const channel_nr_t channel_nr) {
+  uint8_t prev_lo = 0, prev_hi = 0;
+  for (uint8_t x = 0; x < this->_x_border; x += 2) {
+    uint8_t first = sample_at(psample, x);
+    uint8_t second = sample_at(psample, x+1);
+    uint8_t lo = min(first, second);
+    uint8_t hi = max(first, second);
+    uint8_t bar_lo = lo, bar_hi = hi;
+    if (x > 0) {
+      bar_lo = min(lo, prev_hi);
+      bar_hi = max(hi, prev_lo);
+    }
+    int16_t y_lo = _sample_ypixel(bar_lo, channel_nr);
+    int16_t y_hi = _sample_ypixel(bar_hi, channel_nr);
+    this->drawLine((int16_t)x, y_lo, (int16_t)x, y_hi, SH110X_WHITE);
+    this->drawLine((int16_t)(x+1), y_lo, (int16_t)(x+1), y_hi, SH110X_WHITE);
+    prev_lo = lo;
+    prev_hi = hi;
+  }
+}
+
 /*!
  *
  * name: _show_measurement
@@ -947,7 +2040,6 @@ void CMenu::_draw_frequency_value(bool bigsize) {
   if (bigsize) {
     this->print(F(" Hz"));
   }
-  this->display();
 }
 
 void CMenu::_draw_note_value(void) {
@@ -968,7 +2060,6 @@ void CMenu::_draw_note_value(void) {
   xpos = this->_get_procent_xpos(note_index, this->_search_frequency);
   //draw current measured pitch-mark
   this->drawLine(xpos, 30, xpos, 40, SH110X_WHITE);
-  this->display();
 }
 
 void CMenu::_read_frequency(double & freq_meas, const uint16_t multiply) {
@@ -1156,7 +2247,6 @@ uint8_t CMenu::_get_procent_xpos(const uint8_t & noteindex, const uint16_t &curr
   this->print(F("."));
   this->print(abs(permillies - percent_value*10));
   this->print(F("%"));
-  this->display();
   return rtn_value;
 }
 
@@ -1185,6 +2275,62 @@ bool CMenu::_update_draw_request(void) {
   return rtn_value;
 }
 
+/*!
+ *
+ * name:   _auto_range()
+ * @brief  auto-range of channel1: the amplifier is stepped up or down
+ *         on the sample-range of the last frame, collected by the
+ *         ADC-interrupt. Between both limits it is kept (hysteresis).
+ *         The new level is set without waiting for the offset-voltage,
+ *         the range is collected again afterwards.
+ * @param  none
+ * @return none
+ *
+ */
+void CMenu::_auto_range(void) {
+  uint8_t min_value, max_value;
+  if (g_cfg.chan[eChannel_nr1].amplifier != SET_AMP_AUTO) {
+    return;
+  }
+  if (amplifier_settling()) {
+    sample_clear_range();
+    return;
+  }
+  if (sample_get_range(&min_value, &max_value) == false) {
+    return;
+  }
+  uint8_t level = amplifier_level();
+  uint8_t amplitude = max_value - min_value;
+  bool clipped = (min_value == 0) || (max_value >= 63);
+  if ((clipped || (amplitude > AUTORANGE_DOWN_LEVEL)) && (level > SET_AMP_LEVEL_1)) {
+    set_amplifier_level(level - 1);
+  } else if ((clipped == false) && (amplitude < AUTORANGE_UP_LEVEL) && (level < SET_AMP_LEVEL_4)) {
+    set_amplifier_level(level + 1);
+  }
+}
+
+/*!
+ *
+ * name:   _update_statistics()
+ * @brief  reads the acquisition-statistics every STATISTICS_MSEC
+ *         and scales them to waveforms and missed triggers per second.
+ *         the trigger-rate counts the edges accepted by the holdoff.
+ * @param  none
+ * @return none
+ *
+ */
+void CMenu::_update_statistics(void) {
+  unsigned long int elapsed = millis() - _statisticsTimer;
+  if (elapsed >= STATISTICS_MSEC) {
+    uint16_t frames, missed;
+    sample_get_statistics(&frames, &missed);
+    _waveforms_per_sec = (uint16_t)((frames * 1000UL) / elapsed);
+    _missed_per_sec    = (uint16_t)((missed * 1000UL) / elapsed);
+    _triggers_per_sec  = sample_trigger_rate((uint16_t)elapsed);
+    _statisticsTimer += elapsed;
+  }
+}
+
 /*!
  *
  * name:   _is_plugged_in()
@@ -1212,6 +2358,202 @@ bool CMenu::_is_plugged_in(void) {
   return rtn_value;
 }
 
+/*!
+ *
+ * name:   _check_time_limits()
+ * @brief  keeps the sample-times in the possible range:
+ *         channel2 sampling-time depends on channel1,
+ *          sampling-time could be faster, but not less.
+ *         ETS and 10usec (fast acquisition) are only possible on
+ *          a single channel, burst-capture samples both channels alternating.
+ *         roll-mode requires slow sample-times, equal on both channels,
+ *          and runs without trigger.
+ *         segmented memory, averaging and deep memory are only possible on
+ *          a single channel.
+ *         the software trigger and the trigger-qualifier are running in
+ *          the ADC-interrupt, ETS and burst are replaced by 10usec.
+ *         single-shot replaces ETS by burst-capture.
+ *         !! Make sure calling this with cli() interrupts disabled !!
+ * @param  none
+ * @return none
+ *
+ */
+void CMenu::_check_time_limits(void) {
+  if ((g_cfg.chan[eChannel_nr1].trigger_mode == SET_TRIG_SINGLE_P) ||
+      (g_cfg.chan[eChannel_nr1].trigger_mode == SET_TRIG_SINGLE_N)) {
+    //ETS requires repetitive triggers, single-shot uses burst-capture
+    if (g_cfg.chan[eChannel_nr1].time == MENU_TIM_ETS_VALUE) {
+      g_cfg.chan[eChannel_nr1].time = MENU_TIM_BURST_VALUE;
+    }
+  }
+  if ((g_cfg.chan[eChannel_nr1].trigger_mode == SET_TRIG_OFF) &&
+      (g_cfg.chan[eChannel_nr1].time == MENU_TIM_ETS_VALUE)) {
+    //ETS is armed by trigger-edges only, free running falls back to the
+    //  fastest sample-tick. Free running burst-capture is done on every draw
+    g_cfg.chan[eChannel_nr1].time = MENU_TIM_10US_VALUE;
+  }
+  if ((g_cfg.chan[eChannel_nr1].trigger_level >= SET_TRIG_LEVEL_SOFT1) ||
+      (g_cfg.chan[eChannel_nr1].trigger_qual != SET_QUAL_EDGE)) {
+    //software trigger and trigger-qualifier require the ADC-interrupt
+    if (g_cfg.chan[eChannel_nr1].time < MENU_TIM_10US_VALUE) {
+      g_cfg.chan[eChannel_nr1].time = MENU_TIM_10US_VALUE;
+    }
+  }
+  if ((g_cfg.chan[eChannel_nr1].option == SET_OPT_DUAL) ||
+      (g_cfg.chan[eChannel_nr1].option == SET_OPT_DUAL_PLUGGED))
+  {
+    if (g_cfg.chan[eChannel_nr1].time == MENU_TIM_ETS_VALUE) {
+      g_cfg.chan[eChannel_nr1].time = MENU_TIM_BURST_VALUE;
+    }
+    if (g_cfg.chan[eChannel_nr1].time == MENU_TIM_10US_VALUE) {
+      g_cfg.chan[eChannel_nr1].time = MENU_TIM_20US_VALUE;
+    }
+  }
+  if ( (g_cfg.chan[eChannel_nr2].time) > g_cfg.chan[eChannel_nr1].time ) {
+    g_cfg.chan[eChannel_nr2].time = g_cfg.chan[eChannel_nr1].time;
+  }
+  //channel2 doesn't follow channel1 into burst-capture or ETS, fast
+  //  acquisition on dual channel only
+  uint8_t time2_min = MENU_TIM_50US_VALUE;
+  if ((g_cfg.chan[eChannel_nr1].option == SET_OPT_DUAL) ||
+      (g_cfg.chan[eChannel_nr1].option == SET_OPT_DUAL_PLUGGED))
+  {
+    time2_min = MENU_TIM_20US_VALUE;
+  }
+  if (g_cfg.chan[eChannel_nr2].time < time2_min) {
+    g_cfg.chan[eChannel_nr2].time = time2_min;
+  }
+  if (g_cfg.chan[eChannel_nr1].acquisition == SET_ACQ_ROLL) {
+    //roll-mode is free running with same sample-time on both channels
+    if (g_cfg.chan[eChannel_nr1].time < MENU_TIM_ROLL_MIN_VALUE) {
+      g_cfg.chan[eChannel_nr1].time = MENU_TIM_ROLL_MIN_VALUE;
+    }
+    g_cfg.chan[eChannel_nr2].time = g_cfg.chan[eChannel_nr1].time;
+    g_cfg.chan[eChannel_nr1].trigger_mode = SET_TRIG_OFF;
+  }
+  if ((g_cfg.chan[eChannel_nr1].acquisition == SET_ACQ_SEGMENT) ||
+      (g_cfg.chan[eChannel_nr1].acquisition == SET_ACQ_AVERAGE) ||
+      (g_cfg.chan[eChannel_nr1].acquisition == SET_ACQ_DEEP)) {
+    //segmented memory, averaging and deep memory are using the memory
+    //  of channel2
+    if ((g_cfg.chan[eChannel_nr1].option == SET_OPT_DUAL) ||
+        (g_cfg.chan[eChannel_nr1].option == SET_OPT_DUAL_PLUGGED))
+    {
+      g_cfg.chan[eChannel_nr1].option = SET_OPT_SINGLE;
+      g_cfg.chan[eChannel_nr2].status = SET_OFF;
+    }
+  }
+}
+
+/*!
+ *
+ * name:   _autoset_capture()
+ * @brief  autoset: waits for a complete free running frame of channel1,
+ *         sampled after this call, and returns its min/max sample-values.
+ *         On timeout the min/max of the sample-buffer are returned.
+ * @param  uint8_t & min_value
+ * @param  uint8_t & max_value
+ * @return none
+ *
+ */
+void CMenu::_autoset_capture(uint8_t & min_value, uint8_t & max_value) {
+  //timeout: twice the frame-time plus a margin
+  uint32_t timeout = 2 * (sample_interval(eChannel_nr1) * SAMPLE_DATA_SIZE / 10000UL) + AUTOSET_FRAME_MSEC;
+  g_cfg.chan[eChannel_nr1].sample_draw = true;
+  g_cfg.chan[eChannel_nr1].sample_start= true;
+  //the range-statistics are ready after SAMPLE_DATA_SIZE new samples
+  sample_clear_range();
+  unsigned long int start = millis();
+  while (sample_get_range(&min_value, &max_value) == false) {
+    if ((millis() - start) >= timeout) {
+      min_value = 0xFF;
+      max_value = 0;
+      for (uint8_t x = 0; x < SAMPLE_DATA_SIZE; x++) {
+        uint8_t value = pchannel1->data[x];
+        min_value = min(min_value, value);
+        max_value = max(max_value, value);
+      }
+      break;
+    }
+  }
+}
+
+/*!
+ *
+ * name:   _autoset()
+ * @brief  sets sample-time, amplifier, offset and trigger of channel1
+ *         to the input-signal: the sample-time shows 2 periods of the
+ *         measured frequency at least, the amplifier is the highest
+ *         one within 3/4 of the display-height and the offset centers
+ *         the signal. Triggered in mode auto, if a frequency is found.
+ * @param  none
+ * @return none
+ *
+ */
+void CMenu::_autoset(void) {
+  uint8_t min_value, max_value;
+  this->clearDisplay();
+  this->setCursor(0, 0);
+  this->print(STR_MENU_AUTOSET);
+  this->display();
+  //free running, fast sample-time and amplifier *1 for a first look,
+  //  auto-range is kept on
+  bool auto_range = (g_cfg.chan[eChannel_nr1].amplifier == SET_AMP_AUTO);
+  g_cfg.chan[eChannel_nr1].trigger_mode = SET_OFF;
+  g_cfg.chan[eChannel_nr1].amplifier = SET_AMP_LEVEL_1;
+  g_cfg.chan[eChannel_nr1].offset = 0;
+  g_cfg.chan[eChannel_nr1].time_fine = 0;
+  g_cfg.chan[eChannel_nr1].time = MENU_TIM_50US_VALUE;
+  _apply_settings();
+  //frequency of the comparator-edges
+  _frequ_meas_value10 = 0L;
+  unsigned long int start = millis();
+  while ((millis() - start) < AUTOSET_FREQU_MSEC) {
+    _read_frequency(_frequ_meas_value10, 10);
+  }
+  if (_frequ_meas_value10 > 0L) {
+    //smallest sample-time showing 2 periods, period in 0.1usec
+    uint32_t period = (uint32_t)(1.0e8 / _frequ_meas_value10);
+    for (uint8_t time = MENU_TIM_10US_VALUE; time <= MENU_TIM_100MS_VALUE; time++) {
+      g_cfg.chan[eChannel_nr1].time = time;
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        _check_time_limits();
+        set_counter_defaults();
+      } //end ATOMIC_BLOCK()
+      if ((sample_interval(eChannel_nr1) * this->_x_border) >= (2 * period)) {
+        break;
+      }
+    }
+  } else {
+    g_cfg.chan[eChannel_nr1].time = MENU_TIM_1MS_VALUE;
+  }
+  _apply_settings();
+  //highest amplifier within 3/4 of the full sample-range
+  _autoset_capture(min_value, max_value);
+  //  the amplitude is captured at level 1, the gain of a level is its value
+  uint8_t amplitude = max_value - min_value;
+  while ((g_cfg.chan[eChannel_nr1].amplifier < SET_AMP_LEVEL_4) &&
+         ((g_cfg.chan[eChannel_nr1].amplifier + 1) * amplitude < 48))
+  {
+    g_cfg.chan[eChannel_nr1].amplifier++;
+  }
+  if (auto_range) {
+    //auto-range continues with the found level
+    set_amplifier_level(g_cfg.chan[eChannel_nr1].amplifier);
+    g_cfg.chan[eChannel_nr1].amplifier = SET_AMP_AUTO;
+  }
+  set_amplifier(eChannel_nr1);
+  //center the signal
+  _autoset_capture(min_value, max_value);
+  int16_t y_center = (g_cfg.chan[eChannel_nr2].status == SET_ON) ? this->_y_border / 4 : this->_y_border / 2;
+  int16_t offset = _sample_ypixel((min_value + max_value) / 2, eChannel_nr1) - y_center;
+  g_cfg.chan[eChannel_nr1].offset = (int8_t)range(offset, -31, 31);
+  if (_frequ_meas_value10 > 0L) {
+    g_cfg.chan[eChannel_nr1].trigger_mode = SET_TRIG_AUTO_P;
+  }
+  _apply_settings();
+}
+
 /*!
  *
  * name:   _make_checksum()
@@ -1237,12 +2579,15 @@ uint8_t CMenu::_make_checksum(const uint8_t mem_type) {
 /*!
  *
  * name:   _IsEEPROM_data_valid()
+ * @brief  the stored layout has to match and the checksum to be valid.
  * @param  none
  * @return true, if EEPROM-data valid, else false
  *
  */
 bool CMenu::_IsEEPROM_data_valid(void) {
-  if (EEPROM[ADDR_CHECKSUM] == _make_checksum(MEM_TYPE_EEPROM)) {
+  //cfg-data of another layout (older revision) is never used
+  if ((EEPROM[ADDR_CFG_LAYOUT] == CFG_LAYOUT) &&
+      (EEPROM[ADDR_CHECKSUM] == _make_checksum(MEM_TYPE_EEPROM))) {
     return true;
   } else {
     return false;
@@ -1263,11 +2608,12 @@ bool CMenu::_EEPROM_write_cfg(void) {
     checksum = _make_checksum(MEM_TYPE_GLOBAL);
     //write global config-data
     EEPROM.put(ADDR_CFG_DATA_BASE, g_cfg);
-    //write checksum
+    //write checksum and layout
     EEPROM.write(ADDR_CHECKSUM, checksum);
+    EEPROM.write(ADDR_CFG_LAYOUT, CFG_LAYOUT);
   }  //end ATOMIC_BLOCK()
   //compare global config-checksum with EEPROM-checksum
-  if (checksum == _make_checksum(MEM_TYPE_EEPROM)) {
+  if (_IsEEPROM_data_valid() && (checksum == _make_checksum(MEM_TYPE_EEPROM))) {
     rtn_value = true;
   }
   return rtn_value;
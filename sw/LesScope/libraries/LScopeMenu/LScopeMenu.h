@@ -37,11 +37,30 @@
 #endif
 
 #include "rotaryencoder.h"
+#include "LScopeSample.h"
 
 // Show Default Menu for 5 seconds if no encoder-data available.
 #define WAIT4ACTIONS_TIMEOUT 5000
 #define DRAWUPDATE_MSEC       100
 #define DRAWUPDATE_TIMEOUT    500
+// number of menu-rows, rows below row 1 are scrolled on small displays
+#define MENU_ROWS_VISIBLE       8
+#define MENU_ROWS_CHANNEL1     21
+// channel1 menu-row without value, pushing it starts the autoset
+#define MENU_ROW_AUTOSET       21
+#define MENU_ROWS_CHANNEL2      4
+// acquisition-statistics are updated every second
+#define STATISTICS_MSEC      1000
+// auto-range: amplifier up below, down above these sample-ranges (0...63)
+//  or if clipped. The hysteresis is wider than a doubled amplification.
+#define AUTORANGE_UP_LEVEL     24
+#define AUTORANGE_DOWN_LEVEL   56
+// autoset: frequency-measurement and margin of the frame-timeout
+#define AUTOSET_FREQU_MSEC    200
+#define AUTOSET_FRAME_MSEC    300
+// deep memory views: capture of all samples, then 2:1 and 1:1 zoomed,
+//  panned in steps of a quarter display-width (1 + 5 + 13 views)
+#define DEEP_VIEWS             19
 
 typedef enum eMenu {
   STARTUP,            // 0
@@ -57,6 +76,7 @@ typedef enum eMenu {
 
 typedef struct menuctrl_val {
   uint8_t rowindex;
+  uint8_t rowoffset;  //rows scrolled out below row 1
   uint8_t cursor_x;
   uint8_t cursor_y;
   bool mark_on;
@@ -82,7 +102,26 @@ typedef struct note_value {
 #define STR_MENU_TRG_LEVEL    F("TrgLevl: ")
 #define STR_MENU_OFFSET       F("Offset : ")
 #define STR_MENU_OPTION       F("Option : ")
+#define STR_MENU_PRETRIG      F("PreTrig: ")
+#define STR_MENU_ACQUIRE      F("Acquire: ")
+#define STR_MENU_AVERAGE      F("Average: ")
+#define STR_MENU_FINE         F("Fine:    ")
+#define STR_MENU_PERIODS      F("Periods: ")
+#define STR_MENU_AUTOSET      F("Autoset: ")
+#define STR_MENU_SW_LEVEL     F("SwLevel: ")
+#define STR_MENU_SW_HYST      F("SwHyst.: ")
+#define STR_MENU_HOLDOFF      F("Holdoff: ")
+#define STR_MENU_HOLD_VALUE   F("HoldVal: ")
+#define STR_MENU_QUALIFIER    F("Qualify: ")
+#define STR_MENU_QUAL_TIME    F("QualTim: ")
+#define STR_MENU_DIVIDER      F("Divider: ")
+#define STR_MENU_DIV_RESET    F("DivRst.: ")
 
+#define STR_MENU_TIM_ETS      F("2.0")
+#define STR_MENU_TIM_BURST    F("6.5")
+#define STR_MENU_TIM_BURST2   F(" 13")
+#define STR_MENU_TIM_10US     F(" 10")
+#define STR_MENU_TIM_20US     F(" 20")
 #define STR_MENU_TIM_50US     F(" 50")
 #define STR_MENU_TIM_01MS     F("100")
 #define STR_MENU_TIM_02MS     F("200")
@@ -97,17 +136,27 @@ typedef struct note_value {
 #define STR_MENU_MSEC         F("ms")
 #define STR_MENU_USEC         F("us")
 
-#define MENU_TIM_50US_VALUE   1
-#define MENU_TIM_01MS_VALUE   2
-#define MENU_TIM_02MS_VALUE   3
-#define MENU_TIM_05MS_VALUE   4
-#define MENU_TIM_1MS_VALUE    5
-#define MENU_TIM_2MS_VALUE    6
-#define MENU_TIM_5MS_VALUE    7
-#define MENU_TIM_10MS_VALUE   8
-#define MENU_TIM_20MS_VALUE   9
-#define MENU_TIM_50MS_VALUE   10
-#define MENU_TIM_100MS_VALUE  11
+//fast acquisition-mode (channel1 only): ETS, burst, 10usec and 20usec
+//  ETS  : equivalent-time sampling on repetitive signals, 2usec.
+//         requires a trigger-mode and a single channel.
+//  burst: single-shot capture, 6.5usec or 13usec on dual-channel
+#define MENU_TIM_ETS_VALUE    1
+#define MENU_TIM_BURST_VALUE  2
+#define MENU_TIM_10US_VALUE   3
+#define MENU_TIM_20US_VALUE   4
+#define MENU_TIM_50US_VALUE   5
+#define MENU_TIM_01MS_VALUE   6
+#define MENU_TIM_02MS_VALUE   7
+#define MENU_TIM_05MS_VALUE   8
+#define MENU_TIM_1MS_VALUE    9
+#define MENU_TIM_2MS_VALUE    10
+#define MENU_TIM_5MS_VALUE    11
+#define MENU_TIM_10MS_VALUE   12
+#define MENU_TIM_20MS_VALUE   13
+#define MENU_TIM_50MS_VALUE   14
+#define MENU_TIM_100MS_VALUE  15
+//roll-mode: slowest sample-time, the display is scrolled on every sample
+#define MENU_TIM_ROLL_MIN_VALUE  MENU_TIM_5MS_VALUE
 
 #define STR_MENU_LESSCOPE     F("LesScope")
 #define STR_MENU_MODUL_TYPE   F("Dual Channel Scope")
@@ -199,14 +248,37 @@ class CMenu : public Adafruit_SH1106G
     // Flag indicating expired timer to show Default-menu
     menutimer_t _menutimer;
     unsigned long int _drawupdateTimer{0L};
+    //segmented memory: 0:= capture running, 1..n:= review segment n,
+    //  n+1:= review all segments together
+    //deep memory: 0:= capture running, 1..DEEP_VIEWS-1:= review zoomed
+    uint8_t _draw_view{0};
+    //frame averaging: number of averaged frames
+    uint8_t _average_frames{0};
+    //true, while drawing is called by Drawupdate()
+    bool    _in_drawupdate{false};
+    //roll-mode: true after the first complete draw, next index to draw
+    bool    _roll_active{false};
+    uint8_t _roll_index{0};
+    //acquisition-statistics: waveforms, missed and accepted triggers
+    //  per second
+    unsigned long int _statisticsTimer{0L};
+    uint16_t _waveforms_per_sec{0};
+    uint16_t _missed_per_sec{0};
+    uint16_t _triggers_per_sec{0};
+    //duration of the last drawn frame: rendering and display-transfer
+    unsigned long int _frame_usec{0L};
 
     void _draw_frequency_value(bool bigsize=false);
     void _draw_note_value(void);
     uint8_t _index2_ypixel(const uint8_t index);
     void _print_time_str(const uint8_t timevalue);
+    void _print_interval(uint32_t interval, const bool compact);
+    void _print_channel_time(const channel_nr_t channel_nr);
     void _print_trigger_str(const uint8_t triggervalue);
     void _print_triggerlevel_str(const uint8_t triggerlevel);
     void _print_option_str(const uint8_t messvalue);
+    void _print_pretrigger_str(const uint8_t pretrigger);
+    void _print_acquisition_str(const uint8_t acquisition);
     void _print_onoff_str(const uint8_t filtervalue);
     void _print_row_str(const uint8_t index, const channel_nr_t channel_nr);
     void _print_value_str(const uint8_t index, const channel_nr_t channel_nr, const uint8_t oldvalue);
@@ -217,11 +289,31 @@ class CMenu : public Adafruit_SH1106G
     void _get_limits(const uint16_t nominal_freq, uint16_t & lower, uint16_t & upper, const uint8_t percent=3);
     bool _is_inlimits(const uint8_t & noteindex, const uint16_t & current_freq, const uint8_t percent=1);
     bool _update_draw_request(void);
+    void _update_statistics(void);
+    void _auto_range(void);
     bool _is_plugged_in(void);
+    void _check_time_limits(void);
+    void _apply_settings(void);
+    void _autoset(void);
+    void _autoset_capture(uint8_t & min_value, uint8_t & max_value);
 
     void _defaultMenu(void);
     void _InitDisplay(void);
     void _draw_channels(void);
+    void _draw_peak(const sample_t * psample, const channel_nr_t channel_nr);
+    void _draw_roll(void);
+    void _draw_samples(const sample_t * psample, const channel_nr_t channel_nr);
+    uint16_t _period_step(uint8_t & periods);
+    int16_t _trigger_shift(const sample_t * psample, const channel_nr_t channel_nr);
+    uint8_t _column_sample(const sample_t * psample, const uint8_t x, const uint16_t step, const int16_t shift);
+    void _draw_segments(void);
+    void _draw_average(void);
+    void _draw_deep(void);
+    void _deep_view(uint16_t & pan, uint8_t & step);
+    bool _is_view_selectable(void);
+    void _select_draw_view(void);
+    void _draw_time_header(void);
+    int16_t _sample_ypixel(const uint8_t value, const channel_nr_t channel_nr);
     void _show_measurement(void);
     void _saveMenu(bool save_data = false);
 
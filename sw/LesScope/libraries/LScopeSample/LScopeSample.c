@@ -26,43 +26,250 @@
 
 /*
  * used HW-resources:
- *  1. timer2/OCR2A  for signalsampling 50usec timestamps.
+ *  1. timer1/OCR1B  compare match B as ADC auto-trigger for
+ *                   signalsampling, the compare-step is the sample-time
+ *                   (10/20usec in fast acquisition mode) with a fraction
+ *                   of 1/64 cycle for fine sample-times, up to 16bit.
+ *                   Longer sample-times are counted in chunks of
+ *                   sample-ticks.
+ *                   burst-capture runs the ADC free running instead.
+ *                   timer1/ICR1 time-stamps the trigger-edge for
+ *                   equivalent-time sampling (ETS).
+ *                   timer1 is running free with clk/1 (see FreqMeasure).
+ *  2. ADC-interrupt for storing the samples and channel-switching.
+ *  3. timer2/OCR2A  as PWM-TOP for offset-voltage on channel1 only.
  */
 
 #include "LScopeSample.h"
+#include <string.h>
 #include <util/atomic.h>
 
 int16_t _sample_counter1;
 int16_t _sample_counter2;
+//reload-values of the sample-counters, compare-steps to be skipped
+int16_t _counter_reload1;
+int16_t _counter_reload2;
 
 unsigned long int _Trigger_Timeout=0L;
 
-//channel1 sample-data
-sample_t channel1;
-//pointer to channel2 sample-data for dynamic assignment
+//true, while the ADC is converting channel2 (A1)
+volatile bool _adc_chan2_active=false;
+//true, if the channel2 conversion has to be stored as sample
+bool _adc_chan2_due=false;
+//timer1 compare-step of current sample-tick
+uint16_t _sample_step=TIMER1_SAMPLE;
+//50usec sample-ticks per compare-step
+uint8_t _sample_ticks=1;
+//compare-step in use, stretched by the fine sample-time. The fraction
+//  in 1/64 cycles is accumulated in _compare_phase
+uint16_t _compare_step=TIMER1_SAMPLE;
+uint8_t  _compare_fraction=0;
+uint8_t  _compare_phase=0;
+//timer1 time-stamps of the channel1 sample-tick in conversion and of
+//  the trigger, which started the current frame
+uint16_t _sample_stamp;
+uint16_t _trigger_stamp;
+//ADMUX base-setting, ADLAR is set in fast acquisition mode
+uint8_t _admux_base=(1<<REFS0);
+
+//equivalent-time sampling (ETS) data
+//  trigger time-stamp (timer1 input capture)
+uint16_t _ets_trigger;
+//  true, while samples after the trigger-edge are collected
+bool     _ets_armed=false;
+//  bitmask of filled sample-slots, filled slots and triggers per frame
+uint8_t  _ets_filled[SAMPLE_DATA_SIZE/8];
+uint8_t  _ets_slots;
+uint8_t  _ets_triggers;
+//  current dither-value of the sample-tick
+uint8_t  _ets_dither;
+
+//software trigger: channel 0:= off (comparator), 1/2:= channel1/2
+uint8_t  _swtrig_channel=0;
+//  10bit trigger-level, arming-level by hysteresis and slope
+uint16_t _swtrig_level;
+uint16_t _swtrig_arm;
+bool     _swtrig_rising;
+bool     _swtrig_armed=false;
+
+//trigger-holdoff: mode, time in usec or number of edges to ignore
+uint8_t  _holdoff_mode=SET_HOLDOFF_OFF;
+uint32_t _holdoff_usec;
+uint8_t  _holdoff_count;
+//  time-stamp of the last accepted edge, edges still to ignore
+unsigned long int _holdoff_start;
+uint8_t  _holdoff_edges;
+//holdoff- and qualifier-times in 10usec, 1-2-5 steps
+const uint16_t _trigger_10usec[SET_TRIG_TIMES] PROGMEM = {
+  5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000
+};
+
+//single-shot: true on trigger-mode single, true while armed
+bool     _single_mode=false;
+volatile bool _single_armed=false;
+
+//trigger-divider: every _divider edge, counted edges since the last
+//  trigger or reset. With reset the count stops at _divider until the
+//  next reset-pulse on channel2
+uint8_t  _divider=1;
+uint8_t  _divider_count=0;
+bool     _divider_reset=false;
+bool     _reset_armed=false;
+
+//trigger-qualifier: mode and qualifier-time in timer1 clocks
+uint8_t  _qualifier=SET_QUAL_EDGE;
+uint32_t _qual_ticks;
+//  ACO-state after the starting edge of a pulse
+uint8_t  _qual_aco_begin;
+//  true, while a pulse is running
+bool     _qual_pulse=false;
+//  true, if the qualifier-time has elapsed since the last edge
+bool     _qual_elapsed=false;
+//  timer1 clocks since the last edge, extended beyond 16bit by the
+//  ADC-interrupt, and timer1-value of the last update
+uint32_t _edge_ticks;
+uint16_t _edge_stamp;
+
+//acquisition-mode in use, SET_ACQ_NORMAL on fast acquisition
+uint8_t _acquisition=SET_ACQ_NORMAL;
+//true, if every conversion is collected (HiRes, Peak)
+bool    _acquire_ticks=false;
+//acquisition data of every conversion within the sample-interval
+typedef struct acquire {
+  uint32_t sum;   //HiRes: sum of 10bit-conversions
+  uint16_t count; //HiRes: number of conversions
+  uint8_t  min;   //Peak : min/max sample-value
+  uint8_t  max;
+  bool     odd;   //Peak : second sample-interval of a min/max pair
+} acquire_t;
+acquire_t _acquire1;
+acquire_t _acquire2;
+
+//pre-trigger data
+//  number of samples in front of the trigger-position
+uint8_t _pre_samples=0;
+//  samples stored since rearm, trigger is accepted at _pre_samples
+uint8_t _pre_filled1=0;
+//  remaining post-trigger samples
+uint8_t _post_count1;
+uint8_t _post_count2;
+//  channel1 frame is swapped, published together with channel2
+bool    _frame1_pending=false;
+
+//auto-range statistics: min/max of SAMPLE_DATA_SIZE channel1 samples
+uint8_t _range_min=0xFF;
+uint8_t _range_max=0;
+uint8_t _range_count=0;
+//  range of the last complete frame, read by sample_get_range()
+uint8_t _range_frame_min;
+uint8_t _range_frame_max;
+bool    _range_ready=false;
+
+//acquisition-statistics, read and cleared by sample_get_statistics()
+//  published triggered frames, dropped ones aren't counted
+volatile uint16_t _frame_count=0;
+//  trigger-edges, which couldn't start a frame
+volatile uint16_t _missed_triggers=0;
+//  accepted trigger-edges and time-stamp of the first one, the last
+//  one is _Trigger_Timeout. read and cleared by sample_trigger_rate()
+volatile uint16_t _trigger_edges=0;
+unsigned long int _trigger_first=0L;
+
+//channel1 sample-data, ping-pong buffered on triggered sampling:
+//  the ISR fills the back-buffer, while the front-buffer is drawn
+sample_t _channel1_buffer[2];
+sample_t * pchannel1=&_channel1_buffer[0];
+sample_t * _pchannel1_back=&_channel1_buffer[1];
+//pointer to channel2 sample-data for dynamic assignment,
+//  both buffers are assigned together in _shared_memory
 sample_t * pchannel2={NULL};
+sample_t * _pchannel2_back={NULL};
+
+//segmented memory: frames in capture-order, the first two are the
+//  channel1 buffers, the others are assigned at _psegment_buffer
+sample_t * _psegments[SEGMENT_FRAMES];
+sample_t * _psegment_buffer={NULL};
+uint8_t _segment_count=2;
+//  segment in capture, all are captured at _segment_count
+uint8_t _segment_fill=0;
 
-int16_t _counter_values[]={ TIMER2_05MSEC, //0 default
-                            TIMER2_50USEC, //1
-                            TIMER2_01MSEC, //2
-                            TIMER2_02MSEC, //3
-                            TIMER2_05MSEC, //4
-                            TIMER2_1MSEC,  //5
-                            TIMER2_2MSEC,  //6
-                            TIMER2_5MSEC,  //7
-                            TIMER2_10MSEC, //8
-                            TIMER2_20MSEC, //9
-                            TIMER2_50MSEC, //10
-                            TIMER2_100MSEC,//11
-                            TIMER2_50MSEC  //12 unused
+//frame averaging: accumulators of the exponential average, holding
+//  2^average times the sample-value, assigned for averaging only
+uint16_t * _paverage={NULL};
+//  number of averaged frames, restarts on 0
+uint8_t _average_frames=0;
+
+//deep memory: DEEP_SAMPLES ring-buffer of packed samples, 4 samples in
+//  3 bytes. The first groups are stored in the data of both channel1
+//  buffers (index, start and delay are kept), the others are assigned
+//  at _pdeep_buffer.
+#define DEEP_GROUPS_BUFFER  (SAMPLE_DATA_SIZE/3)
+#define DEEP_GROUPS_STATIC  (2*DEEP_GROUPS_BUFFER)
+uint8_t * _pdeep_buffer={NULL};
+
+//statically allocated memory of channel2, used by segmented memory,
+//  averaging or deep memory instead. Channel2 is off on these
+//  acquisition-modes, so there is always one user only.
+union {
+  sample_t channel2[2];
+  sample_t segments[SEGMENT_FRAMES-2];
+  uint16_t average[SAMPLE_DATA_SIZE];
+  uint8_t  deep[(DEEP_SAMPLES/4 - DEEP_GROUPS_STATIC) * 3];
+} _shared_memory;
+//  next write-position and first sample of the frame
+uint16_t _deep_index=0;
+uint16_t _deep_start=0;
+//  pre-trigger samples, samples stored since rearm and post-trigger samples
+uint16_t _deep_pre=0;
+uint16_t _deep_pre_filled=0;
+uint16_t _deep_post;
+
+int16_t _counter_values[]={ TIMER1_05MSEC, //0 default
+                            TIMER1_ETS,    //1
+                            TIMER1_BURST,  //2
+                            TIMER1_10USEC, //3
+                            TIMER1_20USEC, //4
+                            TIMER1_50USEC, //5
+                            TIMER1_01MSEC, //6
+                            TIMER1_02MSEC, //7
+                            TIMER1_05MSEC, //8
+                            TIMER1_1MSEC,  //9
+                            TIMER1_2MSEC,  //10
+                            TIMER1_5MSEC,  //11
+                            TIMER1_10MSEC, //12
+                            TIMER1_20MSEC, //13
+                            TIMER1_50MSEC, //14
+                            TIMER1_100MSEC,//15
+                            TIMER1_50MSEC  //16 unused
                           };
 
+//timer1 compare-steps, depending on channel1 sample-time
+uint16_t _step_values[]={ TIMER1_SAMPLE,       //0 default
+                          TIMER1_SAMPLE_ETS,   //1
+                          TIMER1_SAMPLE_BURST, //2
+                          TIMER1_SAMPLE_10USEC,//3
+                          TIMER1_SAMPLE_20USEC,//4
+                          TIMER1_SAMPLE,       //5
+                          TIMER1_SAMPLE,       //6
+                          TIMER1_SAMPLE,       //7
+                          TIMER1_SAMPLE,       //8
+                          TIMER1_SAMPLE,       //9
+                          TIMER1_SAMPLE,       //10
+                          TIMER1_SAMPLE,       //11
+                          TIMER1_SAMPLE,       //12
+                          TIMER1_SAMPLE,       //13
+                          TIMER1_SAMPLE,       //14
+                          TIMER1_SAMPLE,       //15
+                          TIMER1_SAMPLE        //16 unused
+                        };
+
 
 /*!
  *
  * name: sample_init
  *        : timer- and ADC-initialisation.
- *        : timer2 used as sampling-tick (50usec)).
+ *        : timer1 compare match B used as sampling-tick,
+ *        : which auto-triggers the ADC-conversion on channel1.
  * @param  none
  * @return none
  *
@@ -75,16 +282,19 @@ void sample_init( void )
   PORTC &= (uint8_t)~(1<<PORTC5);
 
   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-    set_counter_defaults();
-    channel1.index = 0;
+    pchannel1->index = 0;
+    _pchannel1_back->index = 0;
     if (pchannel2 != NULL) {
       pchannel2->index = 0;
+      _pchannel2_back->index = 0;
     }
 
     //ADC settings
-    ADCSRA &= 0x90; // ADC enable, clear ADIF interrupt-flag
-    ADCSRA |= 0x04; // prescaler to /16 speed
-    ADCSRB =  0x00; // ADC Free running mode
+    ADMUX  = (1<<REFS0); // AVcc reference, channel A0
+    ADCSRA = (1<<ADEN)|(1<<ADIF)|(1<<ADPS2); // ADC enable, clear ADIF, prescaler to /16 speed
+    // ADC auto trigger source: timer1 compare match B, ACME stays disabled
+    ADCSRB = (1<<ADTS2)|(1<<ADTS0);
+    _adc_chan2_active = false;
 
     //// timer0 is used for millis() / micros() on arduino
       // nothing to do here.
@@ -92,195 +302,1524 @@ void sample_init( void )
     //// timer1 is used for frequency-measurement together as
       //   Input Capture Unit with Analog Comparator Input.
       // { see hw_init() in LScopeSetHW.c }
-
+      // timer1 is running free with clk/1, so compare match B
+      // is used as sample-tick, moved by _sample_step on each tick.
+      // set_counter_defaults() sets the first compare-value and
+      //  the ADC-speed for channel1 sample-time. It also enables
+      //  the ADC auto trigger and ADC interrupt.
+    set_counter_defaults();
 
     ///// Setup timer2
       // base setup is already done with: hw_init() in modul: LScopSetHW.c
-    // set timer2 OCR2A to first compare-value for sample-time
+    // set timer2 OCR2A to PWM-TOP for offset-voltage channel1
     OCR2A = (uint8_t)(TIMER2_SAMPLE);
     // clear pending interrupts for timer2
     TIFR2  = (1<<OCF2B)|(1<<OCF2A)|(1<<TOV2);
-    // Set Interrupt Mask Register for:
-    //  enable Timer2 Compare A interrupt
-    TIMSK2 = (1<<OCIE2A);
+    // no interrupts required on timer2
+    TIMSK2 = 0;
   }  //end ATOMIC_BLOCK()
   _Trigger_Timeout=millis();
+}
 
-  ADCSRA |= (1<<ADSC); //Start ADC conversion
+/*!
+ *
+ * name: _acquire_clear
+ *        : clears the acquisition data of one sample-interval.
+ * @param  acquire_t * pacquire
+ * @return none
+ *
+ */
+static inline void _acquire_clear(acquire_t * pacquire)
+{
+  pacquire->sum = 0;
+  pacquire->count = 0;
+  pacquire->min = 0xFF;
+  pacquire->max = 0;
+  pacquire->odd = false;
 }
 
 /*!
  *
  * name: set_counter_defaults
  *        :sets counter-values to defaults.
+ *        :sets sample-tick and ADC-speed, depending on channel1 sample-time.
+ *        : the sample-tick is widened to the sample-times of both
+ *        : channels, if every 50usec-tick isn't required, and
+ *        : stretched by the fine sample-time of channel1.
+ *        : fast acquisition (<50usec) uses ADC-prescaler /8 and
+ *        : left adjusted 8bit reads from ADCH, burst-capture too.
+ *        : burst-capture disables the ADC-interrupt and auto-trigger,
+ *        : see sample_burst().
+ *        : sets the number of pre-trigger samples.
+ *        !! Make sure calling this with cli() interrupts disabled !!
  * @param  none
  * @return none
  *
  */
 void set_counter_defaults( void )
 {
-  _sample_counter1 = _counter_values[g_cfg.chan[eChannel_nr1].time];
-  _sample_counter2 = _counter_values[g_cfg.chan[eChannel_nr2].time];
+  _sample_step = _step_values[g_cfg.chan[eChannel_nr1].time];
+  if (_sample_step < TIMER1_SAMPLE) {
+    _admux_base = (1<<REFS0)|(1<<ADLAR);
+    // prescaler to /8 speed (2MHz ADC-clock, 6.5usec per conversion),
+    //  don't clear pending ADIF
+    ADCSRA = (ADCSRA & (uint8_t)~((1<<ADIF)|(1<<ADPS2)|(1<<ADPS1)|(1<<ADPS0))) | (1<<ADPS1)|(1<<ADPS0);
+  } else {
+    _admux_base = (1<<REFS0);
+    // prescaler to /16 speed, don't clear pending ADIF
+    ADCSRA = (ADCSRA & (uint8_t)~((1<<ADIF)|(1<<ADPS2)|(1<<ADPS1)|(1<<ADPS0))) | (1<<ADPS2);
+  }
+  if (_adc_chan2_active == false) {
+    ADMUX = _admux_base;
+  }
+  _ets_armed = false;
+  //software trigger on the 10bit-conversions of channel1 or channel2
+  _swtrig_channel = 0;
+  _swtrig_armed = false;
+  if (g_cfg.chan[eChannel_nr1].trigger_mode != SET_OFF) {
+    int16_t hysteresis = SWTRIG_STEP * g_cfg.chan[eChannel_nr1].trigger_hyst;
+    if (g_cfg.chan[eChannel_nr1].trigger_level == SET_TRIG_LEVEL_SOFT1) {
+      _swtrig_channel = 1;
+    } else if (g_cfg.chan[eChannel_nr1].trigger_level == SET_TRIG_LEVEL_SOFT2) {
+      _swtrig_channel = 2;
+    }
+    _swtrig_level = SWTRIG_MID + SWTRIG_STEP * g_cfg.chan[eChannel_nr1].trigger_sw_level;
+    _swtrig_rising = trigger_positive(g_cfg.chan[eChannel_nr1].trigger_mode);
+    if (_swtrig_rising) {
+      _swtrig_arm = (_swtrig_level > hysteresis) ? _swtrig_level - hysteresis : 0;
+    } else {
+      _swtrig_arm = _swtrig_level + hysteresis;
+    }
+  }
+  //trigger-holdoff, the first edge is accepted
+  _holdoff_mode = g_cfg.chan[eChannel_nr1].holdoff_mode;
+  if (_holdoff_mode == SET_HOLDOFF_TIME) {
+    _holdoff_usec = sample_trigger_usec(g_cfg.chan[eChannel_nr1].holdoff);
+    _holdoff_start = micros() - _holdoff_usec;
+  }
+  _holdoff_count = g_cfg.chan[eChannel_nr1].holdoff;
+  _holdoff_edges = 0;
+  //single-shot is armed at once
+  _single_mode = (g_cfg.chan[eChannel_nr1].trigger_mode == SET_TRIG_SINGLE_P) ||
+                 (g_cfg.chan[eChannel_nr1].trigger_mode == SET_TRIG_SINGLE_N);
+  _single_armed = _single_mode;
+  //trigger-divider, the reset requires channel2-samples
+  _divider = range(g_cfg.chan[eChannel_nr1].trigger_div, 1, SET_TRIG_DIV_MAX);
+  _divider_reset = (g_cfg.chan[eChannel_nr1].div_reset == SET_ON) && (pchannel2 != NULL);
+  _divider_count = 0;
+  _reset_armed = false;
+  if (_single_mode) {
+    g_cfg.chan[eChannel_nr1].sample_draw = false;
+  }
+  //trigger-qualifier on the analog comparator only, it requires the
+  //  ADC-interrupt for times beyond the timer1-range
+  _qualifier = SET_QUAL_EDGE;
+  if ((g_cfg.chan[eChannel_nr1].trigger_mode != SET_OFF) &&
+      (_swtrig_channel == 0) && (_sample_step != TIMER1_SAMPLE_BURST) &&
+      (_sample_step != TIMER1_SAMPLE_ETS))
+  {
+    _qualifier = g_cfg.chan[eChannel_nr1].trigger_qual;
+  }
+  _qual_ticks = sample_trigger_usec(g_cfg.chan[eChannel_nr1].qual_time) * (F_CPU / 1000000UL);
+  //positive modes start on the falling comparator-edge
+  _qual_aco_begin = trigger_positive(g_cfg.chan[eChannel_nr1].trigger_mode) ? 0 : (1<<ACO);
+  _qual_pulse = false;
+  _qual_elapsed = false;
+  _edge_ticks = 0;
+  _edge_stamp = TCNT1;
+  //acquisition-modes on the 50usec sample-tick only, segmented and deep
+  //  memory on fast acquisition too, except burst-capture and ETS.
+  //  averaging uses complete frames on every sample-time
+  _acquisition = g_cfg.chan[eChannel_nr1].acquisition;
+  if ((_acquisition == SET_ACQ_DEEP) && (_pdeep_buffer == NULL)) {
+    _acquisition = SET_ACQ_NORMAL;
+  }
+  if ((_sample_step != TIMER1_SAMPLE) && (_acquisition != SET_ACQ_AVERAGE)) {
+    if (((_acquisition != SET_ACQ_SEGMENT) && (_acquisition != SET_ACQ_DEEP)) ||
+        (_sample_step == TIMER1_SAMPLE_BURST) ||
+        (_sample_step == TIMER1_SAMPLE_ETS))
+    {
+      _acquisition = SET_ACQ_NORMAL;
+    }
+  }
+  _average_frames = 0;
+  _acquire_ticks = (_acquisition == SET_ACQ_HIRES) || (_acquisition == SET_ACQ_PEAK);
+  //hardware-timed sample-time: the compare-step covers the sample-ticks
+  //  of both channels, so the ADC-interrupt is only running on samples
+  //  due. HiRes and Peak are converting every sample-tick.
+  uint16_t ticks1 = _counter_values[g_cfg.chan[eChannel_nr1].time] + 1;
+  uint16_t ticks2 = _counter_values[g_cfg.chan[eChannel_nr2].time] + 1;
+  uint8_t fine = g_cfg.chan[eChannel_nr1].time_fine;
+  if ((_sample_step == TIMER1_SAMPLE_BURST) || (_sample_step == TIMER1_SAMPLE_ETS)) {
+    fine = 0;
+  }
+  _sample_ticks = 1;
+  if ((_sample_step == TIMER1_SAMPLE) && (_acquire_ticks == false)) {
+    //greatest common divisor of both sample-times
+    uint16_t gcd = ticks1;
+    uint16_t rest = (pchannel2 != NULL) ? ticks2 : 0;
+    while (rest != 0) {
+      uint16_t next = gcd % rest;
+      gcd = rest;
+      rest = next;
+    }
+    //largest chunk of sample-ticks within a 16bit compare-step
+    uint16_t max_ticks = (0xFFFFUL << TIMER1_FINE_SHIFT) /
+                         ((uint32_t)TIMER1_SAMPLE * (TIMER1_FINE_ONE + fine));
+    _sample_ticks = (gcd > max_ticks) ? max_ticks : gcd;
+    while ((gcd % _sample_ticks) != 0) {
+      _sample_ticks--;
+    }
+    _sample_step = TIMER1_SAMPLE * _sample_ticks;
+  }
+  //fine sample-time in fixed point: integer cycles and 1/64 fraction
+  uint32_t fine_step = (uint32_t)_sample_step * (TIMER1_FINE_ONE + fine);
+  _compare_step = (uint16_t)(fine_step >> TIMER1_FINE_SHIFT);
+  _compare_fraction = (uint8_t)fine_step & (TIMER1_FINE_ONE-1);
+  _compare_phase = 0;
+  _counter_reload1 = ticks1 / _sample_ticks - 1;
+  _counter_reload2 = ticks2 / _sample_ticks - 1;
+  _sample_counter1 = _counter_reload1;
+  _sample_counter2 = _counter_reload2;
+  _acquire_clear(&_acquire1);
+  _acquire_clear(&_acquire2);
+  //pre-trigger in steps of 25%, frames are starting at index:=0 again
+  _pre_samples = g_cfg.chan[eChannel_nr1].pretrigger * (SAMPLE_DATA_SIZE/4);
+  _pre_filled1 = 0;
+  _post_count1 = SAMPLE_DATA_SIZE - _pre_samples;
+  _post_count2 = SAMPLE_DATA_SIZE - _pre_samples;
+  _frame1_pending = false;
+  _deep_pre = g_cfg.chan[eChannel_nr1].pretrigger * (DEEP_SAMPLES/4);
+  _deep_pre_filled = 0;
+  _deep_post = DEEP_SAMPLES - _deep_pre;
+  _deep_index = 0;
+  _deep_start = 0;
+  pchannel1 = &_channel1_buffer[0];
+  pchannel1->index = 0;
+  pchannel1->start = 0;
+  _pchannel1_back = &_channel1_buffer[1];
+  _pchannel1_back->index = 0;
+  _pchannel1_back->start = 0;
+  //segmented memory: captured in order, without front-buffer
+  _psegments[0] = pchannel1;
+  _psegments[1] = _pchannel1_back;
+  _segment_count = 2;
+  if (_psegment_buffer != NULL) {
+    for (uint8_t n = 2; n < SEGMENT_FRAMES; n++) {
+      _psegments[n] = &_psegment_buffer[n-2];
+    }
+    _segment_count = SEGMENT_FRAMES;
+  }
+  _segment_fill = 0;
+  if (_acquisition == SET_ACQ_SEGMENT) {
+    _pchannel1_back = _psegments[0];
+  }
+  if (pchannel2 != NULL) {
+    pchannel2->index = 0;
+    pchannel2->start = 0;
+    _pchannel2_back->index = 0;
+    _pchannel2_back->start = 0;
+  }
+  if (_sample_step == TIMER1_SAMPLE_BURST) {
+    // no sample-tick, ADC is only running within sample_burst()
+    ADCSRA &= (uint8_t)~((1<<ADIF)|(1<<ADATE)|(1<<ADIE));
+  } else {
+    // restart sample-tick from now and enable ADC auto trigger/interrupt
+    OCR1B = TCNT1 + _compare_step;
+    TIFR1 = (1<<OCF1B);
+    ADCSRA = (ADCSRA & (uint8_t)~(1<<ADIF)) | (1<<ADATE)|(1<<ADIE);
+  }
 }
 
-/**
+/*!
+ *
+ * name: sample_alloc_channel2
+ *        : assigns/releases both sample-buffers of channel2 in the
+ *        : shared memory, the buffers are cleared on assignment.
+ *        !! Make sure calling this with cli() interrupts disabled !!
+ * @param  bool enable  true: assign, false: release the buffers
+ * @return none
  *
  */
+void sample_alloc_channel2(const bool enable)
+{
+  if (enable) {
+    if (pchannel2 == NULL) {
+      memset(_shared_memory.channel2, 0, sizeof(_shared_memory.channel2));
+      pchannel2 = &_shared_memory.channel2[0];
+      _pchannel2_back = &_shared_memory.channel2[1];
+    }
+  } else {
+    pchannel2 = NULL;
+    _pchannel2_back = NULL;
+  }
+}
 
 /*!
  *
- * name: is_triggertimeout
- *        : checks the trigger-timer for timeout in trigger-mode: auto.
- *        : return true on timeout and clears the buffer, else false.
+ * name: sample_alloc_segments
+ *        : assigns/releases the segments, which aren't part of the
+ *        : channel1 buffers, in the shared memory of channel2.
+ *        !! Make sure calling this with cli() interrupts disabled !!
+ * @param  bool enable  true: assign, false: release the segments
+ * @return none
  *
- * @param  channel_nr_t eChannel
- * @param  uint8_t menu_timeout
- * @return true if trigger-event timed out, else false.
+ */
+void sample_alloc_segments(const bool enable)
+{
+  if (enable) {
+    _psegment_buffer = _shared_memory.segments;
+  } else if (_psegment_buffer != NULL) {
+    _psegment_buffer = NULL;
+    _segment_count = 2;
+  }
+}
+
+/*!
+ *
+ * name: sample_alloc_average
+ *        : assigns/releases the accumulators of frame averaging in the
+ *        : shared memory of channel2.
+ *        !! Make sure calling this with cli() interrupts disabled !!
+ * @param  bool enable  true: assign, false: release the accumulators
+ * @return none
  *
  */
-bool is_triggertimeout(channel_nr_t eChannel, const uint8_t menu_timeout) {
-  bool rtn_value=false;
-  uint16_t max_timeout=TRIGGER_TIMEOUT_VALUE_MSEC;
-  if ((g_cfg.chan[eChannel].trigger_mode == SET_TRIG_AUTO_P) || \
-      (g_cfg.chan[eChannel].trigger_mode == SET_TRIG_AUTO_N))
-  {
-    if ( g_cfg.chan[eChannel].time > menu_timeout ) {
-      max_timeout = 4 * TRIGGER_TIMEOUT_VALUE_MSEC;
+void sample_alloc_average(const bool enable)
+{
+  if (enable) {
+    if (_paverage == NULL) {
+      _paverage = _shared_memory.average;
+      _average_frames = 0;
     }
-    if ((uint16_t)(millis() - _Trigger_Timeout) > max_timeout) {
-      //clear sample-buffer
-      for (uint8_t x = 0; x < SAMPLE_DATA_SIZE; x++) {
-        if (eChannel == eChannel_nr1) {
-          channel1.data[x]=31; //set to offset-value channel1
-        } else {
-          pchannel2->data[x]=45; //set to offset-value channel2
-        }
+  } else {
+    _paverage = NULL;
+  }
+}
+
+/*!
+ *
+ * name: sample_alloc_deep
+ *        : assigns/releases the part of deep memory, which doesn't
+ *        : fit into the channel1 buffers, in the shared memory of
+ *        : channel2.
+ *        !! Make sure calling this with cli() interrupts disabled !!
+ * @param  bool enable  true: assign, false: release the buffer
+ * @return none
+ *
+ */
+void sample_alloc_deep(const bool enable)
+{
+  _pdeep_buffer = (enable) ? _shared_memory.deep : NULL;
+}
+
+/*!
+ *
+ * name: _deep_group
+ *        : address of the 3 bytes holding deep memory position pos.
+ * @param  uint16_t pos  0 ... DEEP_SAMPLES-1
+ * @return uint8_t *
+ *
+ */
+static inline uint8_t * _deep_group(const uint16_t pos)
+{
+  uint8_t group = pos / 4;
+  if (group < DEEP_GROUPS_BUFFER) {
+    return _channel1_buffer[0].data + 3 * group;
+  }
+  if (group < DEEP_GROUPS_STATIC) {
+    return _channel1_buffer[1].data + 3 * (uint8_t)(group - DEEP_GROUPS_BUFFER);
+  }
+  return _pdeep_buffer + 3 * (uint8_t)(group - DEEP_GROUPS_STATIC);
+}
+
+/*!
+ *
+ * name: _deep_write
+ *        : stores a 6bit sample-value packed at deep memory position pos:
+ *        :  byte0: b1b0 a5..a0, byte1: c3..c0 b5..b2, byte2: d5..d0 c5c4
+ * @param  uint16_t pos    0 ... DEEP_SAMPLES-1
+ * @param  uint8_t  value  sample-value 0 ... 63
+ * @return none
+ *
+ */
+static inline void _deep_write(const uint16_t pos, const uint8_t value)
+{
+  uint8_t * p = _deep_group(pos);
+  switch (pos & 0x03) {
+    case 0:
+      p[0] = (p[0] & 0xC0) | value;
+    break;
+    case 1:
+      p[0] = (p[0] & 0x3F) | (uint8_t)(value << 6);
+      p[1] = (p[1] & 0xF0) | (value >> 2);
+    break;
+    case 2:
+      p[1] = (p[1] & 0x0F) | (uint8_t)(value << 4);
+      p[2] = (p[2] & 0xFC) | (value >> 4);
+    break;
+    default:
+      p[2] = (p[2] & 0x03) | (uint8_t)(value << 2);
+    break;
+  }
+}
+
+/*!
+ *
+ * name: sample_deep_at
+ *        : deep memory sample-value at frame-position x, the frame is
+ *        : read rotated around its start like sample_at().
+ * @param  uint16_t x  frame-position 0 ... DEEP_SAMPLES-1
+ * @return uint8_t  sample-value
+ *
+ */
+uint8_t sample_deep_at(const uint16_t x)
+{
+  uint16_t pos = (_deep_start + x) & DEEP_INDEX_MASK;
+  const uint8_t * p = _deep_group(pos);
+  switch (pos & 0x03) {
+    case 0:
+      return p[0] & 0x3F;
+    case 1:
+      return (p[0] >> 6) | ((p[1] & 0x0F) << 2);
+    case 2:
+      return (p[1] >> 4) | ((p[2] & 0x03) << 4);
+    default:
+      return p[2] >> 2;
+  }
+}
+
+/*!
+ *
+ * name: sample_average_frame
+ *        : adds the channel1 front-buffer to the exponential average,
+ *        : called from main-loop on every new triggered frame.
+ *        : The first frame presets the accumulators.
+ * @param  none
+ * @return uint8_t  number of averaged frames (max. 255)
+ *
+ */
+uint8_t sample_average_frame( void )
+{
+  if (_paverage != NULL) {
+    uint8_t shift = g_cfg.chan[eChannel_nr1].average;
+    for (uint8_t x = 0; x < SAMPLE_DATA_SIZE; x++) {
+      uint16_t value = sample_at(pchannel1, x);
+      if (_average_frames == 0) {
+        _paverage[x] = value << shift;
+      } else {
+        _paverage[x] = _paverage[x] - (_paverage[x] >> shift) + value;
       }
-      rtn_value=true;
     }
+    if (_average_frames < 255) {
+      _average_frames++;
+    }
+  }
+  return _average_frames;
+}
+
+/*!
+ *
+ * name: sample_average_at
+ *        : averaged sample-value at frame-position x.
+ * @param  uint8_t x  frame-position
+ * @return uint8_t  sample-value, rounded
+ *
+ */
+uint8_t sample_average_at(const uint8_t x)
+{
+  uint8_t shift = g_cfg.chan[eChannel_nr1].average;
+  if (_paverage == NULL) {
+    return sample_at(pchannel1, x);
+  }
+  return (uint8_t)((_paverage[x] + (1<<(shift-1))) >> shift);
+}
+
+/*!
+ *
+ * name: sample_segments
+ *        : number of segments on segmented memory.
+ * @param  none
+ * @return uint8_t  number of segments
+ *
+ */
+uint8_t sample_segments( void )
+{
+  return _segment_count;
+}
+
+/*!
+ *
+ * name: sample_segment
+ *        : sample-data of a segment on segmented memory.
+ * @param  uint8_t segment  0 ... sample_segments()-1, in capture-order
+ * @return const sample_t *  sample-data, NULL on invalid segments
+ *
+ */
+const sample_t * sample_segment(const uint8_t segment)
+{
+  return (segment < _segment_count) ? _psegments[segment] : NULL;
+}
+
+/*!
+ *
+ * name: sample_get_statistics
+ *        : reads and clears the acquisition-statistics.
+ * @param  uint16_t * pframes   finished triggered frames
+ * @param  uint16_t * pmissed   trigger-edges, which couldn't start a frame
+ * @return none
+ *
+ */
+void sample_get_statistics(uint16_t * pframes, uint16_t * pmissed)
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    *pframes = _frame_count;
+    *pmissed = _missed_triggers;
+    _frame_count = 0;
+    _missed_triggers = 0;
+  }
+}
+
+/*!
+ *
+ * name: sample_get_range
+ *        : reads min/max of the last SAMPLE_DATA_SIZE channel1 samples,
+ *        : collected by the ADC-interrupt for auto-range.
+ * @param  uint8_t * pmin  min. sample-value
+ * @param  uint8_t * pmax  max. sample-value
+ * @return true if a new range is available, else false
+ *
+ */
+bool sample_get_range(uint8_t * pmin, uint8_t * pmax)
+{
+  bool rtn_value;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    rtn_value = _range_ready;
+    *pmin = _range_frame_min;
+    *pmax = _range_frame_max;
+    _range_ready = false;
   }
   return rtn_value;
 }
 
-////////////////////////////////////////////////////////////////
-// ISR - handlers aren't used for Timer0 and Timer1
-//  they are used for:
-//   Timer0: millis() / micros()
-//   Timer1: frequency-measurement
-////////////////////////////////////////////////////////////////
+/*!
+ *
+ * name: sample_clear_range
+ *        : restarts the range collection, e.g. after amplifier-changes.
+ * @param  none
+ * @return none
+ *
+ */
+void sample_clear_range( void )
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    _range_min = 0xFF;
+    _range_max = 0;
+    _range_count = 0;
+    _range_ready = false;
+  }
+}
 
 /*!
  *
- * name: ISR interrupt-service routine
- * @brief  Interrupt Service for Timer2 compare match A.
+ * name: sample_acquisition
+ *        : acquisition-mode in use, SET_ACQ_NORMAL on fast acquisition.
+ * @param  none
+ * @return uint8_t  SET_ACQ_xxx
+ *
+ */
+uint8_t sample_acquisition( void )
+{
+  return _acquisition;
+}
+
+/*!
+ *
+ * name: sample_interval
+ *        : real sample-interval of a channel, computed in fixed point
+ *        : from the compare-step including its fraction.
+ * @param  channel_nr_t eChannel
+ * @return uint32_t  sample-interval in 0.1usec, 0 on burst-capture and ETS
+ *
+ */
+uint32_t sample_interval(const channel_nr_t eChannel)
+{
+  uint32_t step;
+  uint16_t steps;
+  if ((_sample_step == TIMER1_SAMPLE_BURST) || (_sample_step == TIMER1_SAMPLE_ETS)) {
+    return 0;
+  }
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    step = ((uint32_t)_compare_step << TIMER1_FINE_SHIFT) + _compare_fraction;
+    steps = ((eChannel == eChannel_nr1) ? _counter_reload1 : _counter_reload2) + 1;
+  }
+  //1/64 cycles to 0.1usec: 1.6 cycles each on 16MHz
+  return (step * steps * 5) >> (TIMER1_FINE_SHIFT + 3);
+}
+
+//the blocked burst-capture mustn't lose a timer1 overflow
+#if (BURST_BLOCK_CYCLES >= 65536UL)
+  #error "burst-capture blocks longer than a timer1 overflow period"
+#endif
+
+/*!
+ *
+ * name: _sample_burst
+ *        : single-shot capture of a complete sample-buffer without any
+ *        : interrupt per sample. The ADC is free running, so every
+ *        : conversion takes exactly 13 ADC-clocks (104 cpu-cycles on
+ *        : prescaler /8), the loop needs less than that per sample.
+ *        : All interrupts are blocked for BURST_BLOCK_CYCLES at most:
+ *        : 0.84msec single, 1.67msec dual channel. Pending interrupts
+ *        : are served afterwards: the timer1 overflow of FreqMeasure
+ *        : isn't lost (4.1msec period), millis() may lag 1msec after
+ *        : a dual channel capture.
+ *        : On dual-channel the ADMUX is toggled on every result, which
+ *        : takes effect one conversion later: the first result is
+ *        : dropped, then A0/A1 results are alternating.
+ *        !! Make sure calling this with cli() interrupts disabled !!
  * @param  none
  * @return none
  *
  */
-ISR(TIMER2_COMPA_vect)
+static void _sample_burst( void )
 {
-  ///// testpin options, activate as required
-  // Testpin Toggle PortC PC5
-  // PINC = (1<<PINC5);
-  // set Testpin high or
-  PORTC |= (1<<PORTC5);
-  // set Testpin low
-  // PORTC &= (uint8_t)~(1<<PORTC5);
-  /////
+  uint8_t * pdata1 = pchannel1->data;
+  uint8_t * pdata2 = NULL;
+  uint8_t admux_ch1 = _admux_base;
+  uint8_t admux_ch2 = _admux_base|(1<<MUX0);
 
-  if (g_cfg.chan[eChannel_nr1].sample_start) {
-    if (_sample_counter1 > 0) {
-      _sample_counter1--;
-    } else {
-      // stop auto trigger
-      ADCSRA &= (uint8_t)~(1<<ADATE);
-      // set channel A0 -->> ~((1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0))
-      ADMUX = (1<<REFS0);
-      // start the ADC-conversion
-      ADCSRA |= (1<<ADSC);
-      // ADSC is cleared when the conversion finishes
-      while ((ADCSRA & (1<<ADSC))) {};
-      //get value from ADCL/ADCH and save it
-      channel1.data[channel1.index] = ADC/16;
-      channel1.index++;
-      if (channel1.index >= SAMPLE_DATA_SIZE) {
-        channel1.index = 0;
-        if (g_cfg.chan[eChannel_nr1].trigger_mode != SET_OFF) {
-          g_cfg.chan[eChannel_nr1].sample_start = false;
-          g_cfg.chan[eChannel_nr1].sample_draw  = true;
-        }
-      }
-      _sample_counter1  = _counter_values[g_cfg.chan[eChannel_nr1].time];
+  if ((pchannel2 != NULL) && \
+      ((g_cfg.chan[eChannel_nr2].status == 1) || \
+       (g_cfg.chan[eChannel_nr1].option  == SET_OPT_DUAL_PLUGGED)))
+  {
+    pdata2 = pchannel2->data;
+  }
+  PORTC |= (1<<PORTC5);
+  // ADC free running mode with channel A0
+  ADCSRB = 0x00;
+  ADMUX  = admux_ch1;
+  ADCSRA |= (1<<ADIF)|(1<<ADATE)|(1<<ADSC);
+  // first result is dropped, on dual-channel A1 is selected for the third
+  while ((ADCSRA & (1<<ADIF)) == 0) {};
+  ADCSRA |= (1<<ADIF);
+  if (pdata2 != NULL) {
+    ADMUX = admux_ch2;
+    for (uint8_t x = 0; x < SAMPLE_DATA_SIZE; x++) {
+      // result of channel1
+      while ((ADCSRA & (1<<ADIF)) == 0) {};
+      ADCSRA |= (1<<ADIF);
+      ADMUX = admux_ch1;
+      pdata1[x] = ADCH/4;
+      // result of channel2
+      while ((ADCSRA & (1<<ADIF)) == 0) {};
+      ADCSRA |= (1<<ADIF);
+      ADMUX = admux_ch2;
+      pdata2[x] = ADCH/4;
     }
+    pchannel2->index = 0;
+    pchannel2->start = 0;
+    g_cfg.chan[eChannel_nr2].sample_draw = true;
   } else {
-    _sample_counter1  = _counter_values[g_cfg.chan[eChannel_nr1].time];
-  }
-  //sample channel2, if required
-  if (g_cfg.chan[eChannel_nr2].sample_draw  == false) {
-    if ((g_cfg.chan[eChannel_nr2].status == 1) || \
-        (g_cfg.chan[eChannel_nr1].option  == SET_OPT_DUAL_PLUGGED)
-      )
-    {
-      if (_sample_counter2 > 0) {
-        _sample_counter2--;
-      } else {
-        // stop auto trigger
-        ADCSRA &= (uint8_t)~(1<<ADATE);
-        // set channel A1 -->> (1<<MUX0)
-        ADMUX = (1<<REFS0)|(1<<MUX0);
-        // start the ADC-conversion
-        ADCSRA |= (1<<ADSC);
-        // ADSC is cleared when the conversion finishes
-        while ((ADCSRA & (1<<ADSC))) {};
-        //get value from ADCL/ADCH and save it
-        if (pchannel2 != NULL) {
-          pchannel2->data[pchannel2->index] = ADC/16;
-          pchannel2->index++;
-          if (pchannel2->index >= SAMPLE_DATA_SIZE) {
-            pchannel2->index = 0;
-            g_cfg.chan[eChannel_nr2].sample_draw = true;
-          }
-        }
-        _sample_counter2  = _counter_values[g_cfg.chan[eChannel_nr2].time];
-
-        ///// testpin options, activate as required
-        //set Testpin low
-        PORTC &= (uint8_t)~(1<<PORTC5);
-      }
+    for (uint8_t x = 0; x < SAMPLE_DATA_SIZE; x++) {
+      while ((ADCSRA & (1<<ADIF)) == 0) {};
+      ADCSRA |= (1<<ADIF);
+      pdata1[x] = ADCH/4;
     }
   }
-} //end TIMER2_COMPA_vect
+  // stop free running and wait for the last started conversion
+  ADCSRA &= (uint8_t)~((1<<ADIF)|(1<<ADATE));
+  while ((ADCSRA & (1<<ADSC))) {};
+  ADCSRA |= (1<<ADIF);
+  ADMUX  = admux_ch1;
+  // back to auto trigger source: timer1 compare match B
+  ADCSRB = (1<<ADTS2)|(1<<ADTS0);
+  pchannel1->index = 0;
+  pchannel1->start = 0;
+  PORTC &= (uint8_t)~(1<<PORTC5);
+}
 
 /*!
  *
- * name: ISR interrupt-service routine
- * @brief  Interrupt Service for Analog Comparator.
+ * name: sample_burst
+ *        : burst-capture from main-loop, used on free running draws
+ *        : (trigger:off). On triggered draws the capture is started
+ *        : within the analog comparator interrupt, so the frame starts
+ *        : at the trigger-edge. Both are blocking, see _sample_burst().
  * @param  none
  * @return none
  *
  */
-ISR(ANALOG_COMP_vect)
+void sample_burst( void )
 {
-  // Testpin Toggle PortC PC5
-  //PINC = (1<<PINC5);
-
-  if ( g_cfg.chan[eChannel_nr1].trigger_mode != SET_OFF ) {
-    if (g_cfg.chan[eChannel_nr1].sample_draw == false) {
-      if ( g_cfg.chan[eChannel_nr1].sample_start == false ) {
-        //reset index channel1 for start sampling with index:=0
-        channel1.index = 0;
-        _sample_counter1 = 0;
-        if (pchannel2 != NULL) {
-          //reset index channel2 at this trigger-time for best drawing
-          pchannel2->index = 0;
-        }
-        _sample_counter2 = 0;
-        g_cfg.chan[eChannel_nr1].sample_start = true;
-        g_cfg.chan[eChannel_nr2].sample_start = true;
-  //  Testpin Toggle PortC PC5
-  //PINC = (1<<PINC5);
-      }
+  if (_sample_step == TIMER1_SAMPLE_BURST) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      _sample_burst();
     }
   }
-  _Trigger_Timeout=millis();
+}
+
+/**
+ *
+ */
+
+/*!
+ *
+ * name: sample_trigger_usec
+ *        : holdoff- or qualifier-time of the given time-index.
+ * @param  uint8_t index  0...SET_TRIG_TIMES-1
+ * @return time in usec
+ *
+ */
+uint32_t sample_trigger_usec(const uint8_t index)
+{
+  uint8_t i = (index < SET_TRIG_TIMES) ? index : SET_TRIG_TIMES - 1;
+  return 10UL * pgm_read_word(&_trigger_10usec[i]);
+}
+
+/*!
+ *
+ * name: sample_single_arm
+ *        : re-arms the single-shot. The kept frame is released, the
+ *        : next trigger-edge is captured by the interrupt at once.
+ * @param  none
+ * @return none
+ *
+ */
+void sample_single_arm(void)
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if (_single_mode) {
+      _single_armed = true;
+      g_cfg.chan[eChannel_nr1].sample_draw = false;
+    }
+  }
+}
+
+/*!
+ *
+ * name: sample_single_armed
+ * @param  none
+ * @return true, while the single-shot waits for its trigger
+ *
+ */
+bool sample_single_armed(void)
+{
+  return _single_armed;
+}
+
+/*!
+ *
+ * name: sample_trigger_rate
+ *        : reads and clears the accepted trigger-edges. The rate is
+ *        : taken from the time-stamps of the first and the last edge,
+ *        : so it's exact on slow repetitive triggers too.
+ * @param  uint16_t elapsed  msec since the last call
+ * @return trigger-rate in Hz
+ *
+ */
+uint16_t sample_trigger_rate(const uint16_t elapsed)
+{
+  uint16_t edges;
+  unsigned long int first, last;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    edges = _trigger_edges;
+    first = _trigger_first;
+    last  = _Trigger_Timeout;
+    _trigger_edges = 0;
+  }
+  if ((edges >= 2) && (last != first)) {
+    return (uint16_t)(((edges - 1) * 1000UL) / (last - first));
+  }
+  return (elapsed > 0) ? (uint16_t)((edges * 1000UL) / elapsed) : 0;
+}
+
+/*!
+ *
+ * name: is_triggertimeout
+ *        : checks the trigger-timer for timeout in trigger-mode: auto.
+ *        : return true on timeout and clears the buffer, else false.
+ *
+ * @param  channel_nr_t eChannel
+ * @param  uint8_t menu_timeout
+ * @return true if trigger-event timed out, else false.
+ *
+ */
+bool is_triggertimeout(channel_nr_t eChannel, const uint8_t menu_timeout) {
+  bool rtn_value=false;
+  uint16_t max_timeout=TRIGGER_TIMEOUT_VALUE_MSEC;
+  if ((g_cfg.chan[eChannel].trigger_mode == SET_TRIG_AUTO_P) || \
+      (g_cfg.chan[eChannel].trigger_mode == SET_TRIG_AUTO_N))
+  {
+    if ( g_cfg.chan[eChannel].time > menu_timeout ) {
+      max_timeout = 4 * TRIGGER_TIMEOUT_VALUE_MSEC;
+    }
+    if ((uint16_t)(millis() - _Trigger_Timeout) > max_timeout) {
+      //clear sample-buffer
+      if ((eChannel == eChannel_nr1) && (_acquisition == SET_ACQ_DEEP)) {
+        for (uint16_t x = 0; x < DEEP_SAMPLES; x++) {
+          _deep_write(x, 31); //set to offset-value channel1
+        }
+      } else {
+        for (uint8_t x = 0; x < SAMPLE_DATA_SIZE; x++) {
+          if (eChannel == eChannel_nr1) {
+            pchannel1->data[x]=31; //set to offset-value channel1
+          } else {
+            pchannel2->data[x]=45; //set to offset-value channel2
+          }
+        }
+      }
+      rtn_value=true;
+    }
+  }
+  return rtn_value;
+}
+
+/*!
+ *
+ * name: _store_deep
+ *        : stores one channel1 sample into deep memory. Free running as
+ *        : continuous ring-buffer, triggered the frame is finished after
+ *        : the post-trigger samples and kept until drawn.
+ * @param  uint8_t value  sample-value
+ * @return none
+ *
+ */
+static inline void _store_deep(const uint8_t value)
+{
+  bool triggered = (g_cfg.chan[eChannel_nr1].trigger_mode != SET_OFF);
+  if (triggered && g_cfg.chan[eChannel_nr1].sample_draw) {
+    //single buffered, wait for drawing
+    return;
+  }
+  _deep_write(_deep_index, value);
+  _deep_index = (_deep_index + 1) & DEEP_INDEX_MASK;
+  if (triggered) {
+    if (g_cfg.chan[eChannel_nr1].sample_start) {
+      if (--_deep_post == 0) {
+        _frame_count++;
+        g_cfg.chan[eChannel_nr1].sample_start = false;
+        g_cfg.chan[eChannel_nr1].sample_draw  = true;
+        _deep_post = DEEP_SAMPLES - _deep_pre;
+        _deep_pre_filled = 0;
+      }
+    } else if (_deep_pre_filled < _deep_pre) {
+      _deep_pre_filled++;
+    }
+  }
+}
+
+/*!
+ *
+ * name: _channel2_capturing
+ *        : true, while channel2 is sampled into a triggered frame.
+ * @param  none
+ * @return bool
+ *
+ */
+static inline bool _channel2_capturing(void)
+{
+  return (_pchannel2_back != NULL) &&
+         g_cfg.chan[eChannel_nr2].sample_start &&
+         ((g_cfg.chan[eChannel_nr2].status == 1) ||
+          (g_cfg.chan[eChannel_nr1].option  == SET_OPT_DUAL_PLUGGED));
+}
+
+/*!
+ *
+ * name: _store_channel1
+ *        : stores one channel1 sample. Free running into the front-buffer,
+ *        : triggered as continuous ring-buffer into the back-buffer
+ *        : until the trigger-edge, then the post-trigger samples are
+ *        : following. Sampling goes on into the back-buffer while drawing.
+ * @param  uint8_t value  sample-value
+ * @return none
+ *
+ */
+static inline void _store_channel1(const uint8_t value)
+{
+  //auto-range statistics on every sample, even if it isn't stored
+  if (value < _range_min) {
+    _range_min = value;
+  }
+  if (value > _range_max) {
+    _range_max = value;
+  }
+  if (++_range_count >= SAMPLE_DATA_SIZE) {
+    _range_frame_min = _range_min;
+    _range_frame_max = _range_max;
+    _range_ready = true;
+    _range_min = 0xFF;
+    _range_max = 0;
+    _range_count = 0;
+  }
+  if (_acquisition == SET_ACQ_DEEP) {
+    _store_deep(value);
+  } else if (g_cfg.chan[eChannel_nr1].trigger_mode == SET_OFF) {
+    pchannel1->data[pchannel1->index] = value;
+    pchannel1->index = (pchannel1->index + 1) & SAMPLE_INDEX_MASK;
+  } else {
+    if ((_acquisition == SET_ACQ_SEGMENT) && (_segment_fill >= _segment_count)) {
+      if (g_cfg.chan[eChannel_nr1].sample_draw) {
+        //all segments are captured, wait for drawing and review
+        return;
+      }
+      //capture again, beginning with the first segment
+      _segment_fill = 0;
+      _pchannel1_back = _psegments[0];
+      _pre_filled1 = 0;
+    }
+    _pchannel1_back->data[_pchannel1_back->index] = value;
+    _pchannel1_back->index = (_pchannel1_back->index + 1) & SAMPLE_INDEX_MASK;
+    if (g_cfg.chan[eChannel_nr1].sample_start) {
+      if (_post_count1 == (SAMPLE_DATA_SIZE - _pre_samples)) {
+        //first post-trigger sample, sub-sample position of the trigger
+        _pchannel1_back->delay = (int16_t)(_sample_stamp - _trigger_stamp);
+      }
+      if (--_post_count1 == 0) {
+        if (_acquisition == SET_ACQ_SEGMENT) {
+          //segmented memory: the next frame follows in the next segment
+          //  without any rearm by drawing
+          _frame_count++;
+          if (++_segment_fill < _segment_count) {
+            _pchannel1_back = _psegments[_segment_fill];
+          } else {
+            g_cfg.chan[eChannel_nr1].sample_draw  = true;
+          }
+        } else if (g_cfg.chan[eChannel_nr1].sample_draw == false) {
+          // front-buffer is drawn, swap buffers. Otherwise the
+          //  frame is dropped and the back-buffer refilled.
+          sample_t * pswap = pchannel1;
+          pchannel1 = _pchannel1_back;
+          _pchannel1_back = pswap;
+          if (_channel2_capturing() && (_frame1_pending == false)) {
+            //channel2 finishes its frame with the next conversion(s),
+            //  both frames are published together by _store_channel2()
+            _frame1_pending = true;
+          } else {
+            _frame1_pending = false;
+            _frame_count++;
+            g_cfg.chan[eChannel_nr1].sample_draw  = true;
+          }
+        }
+        //rearm at once
+        g_cfg.chan[eChannel_nr1].sample_start = false;
+        _post_count1 = SAMPLE_DATA_SIZE - _pre_samples;
+        _pre_filled1 = 0;
+      }
+    } else if (_pre_filled1 < _pre_samples) {
+      _pre_filled1++;
+    }
+  }
+}
+
+/*!
+ *
+ * name: _store_channel2
+ *        : stores one channel2 sample, same buffering as channel1.
+ *        : The triggered frame follows the trigger-position of channel1.
+ * @param  uint8_t value  sample-value
+ * @return none
+ *
+ */
+static inline void _store_channel2(const uint8_t value)
+{
+  if (g_cfg.chan[eChannel_nr1].trigger_mode == SET_OFF) {
+    pchannel2->data[pchannel2->index] = value;
+    pchannel2->index = (pchannel2->index + 1) & SAMPLE_INDEX_MASK;
+    if (pchannel2->index == 0) {
+      g_cfg.chan[eChannel_nr2].sample_draw = true;
+    }
+  } else {
+    _pchannel2_back->data[_pchannel2_back->index] = value;
+    _pchannel2_back->index = (_pchannel2_back->index + 1) & SAMPLE_INDEX_MASK;
+    if (g_cfg.chan[eChannel_nr2].sample_start) {
+      // triggered: frame is finished after the post-trigger samples
+      if (_post_count2 == (SAMPLE_DATA_SIZE - _pre_samples)) {
+        _pchannel2_back->delay = (int16_t)(_sample_stamp - _trigger_stamp);
+      }
+      if (--_post_count2 == 0) {
+        // channel2 is drawn together with channel1, so its front-buffer
+        //  is free only while channel1 isn't drawn
+        if ((g_cfg.chan[eChannel_nr2].sample_draw == false) &&
+            (g_cfg.chan[eChannel_nr1].sample_draw == false)) {
+          // front-buffer is drawn, swap buffers
+          sample_t * pswap = pchannel2;
+          pchannel2 = _pchannel2_back;
+          _pchannel2_back = pswap;
+          g_cfg.chan[eChannel_nr2].sample_draw  = true;
+        }
+        if (_frame1_pending) {
+          //publish the channel1 frame of the same trigger
+          _frame1_pending = false;
+          _frame_count++;
+          g_cfg.chan[eChannel_nr1].sample_draw  = true;
+        }
+        g_cfg.chan[eChannel_nr2].sample_start = false;
+        _post_count2 = SAMPLE_DATA_SIZE - _pre_samples;
+      }
+    }
+  }
+}
+
+/*!
+ *
+ * name: _acquire_conversion
+ *        : collects every conversion within the sample-interval,
+ *        : used on acquisition-modes HiRes and Peak.
+ * @param  acquire_t * pacquire
+ * @param  uint16_t conversion  10bit ADC-value
+ * @return none
+ *
+ */
+static inline void _acquire_conversion(acquire_t * pacquire, const uint16_t conversion)
+{
+  if (_acquisition == SET_ACQ_HIRES) {
+    pacquire->sum += conversion;
+    pacquire->count++;
+  } else {
+    uint8_t value = conversion/16;
+    if (value < pacquire->min) {
+      pacquire->min = value;
+    }
+    if (value > pacquire->max) {
+      pacquire->max = value;
+    }
+  }
+}
+
+/*!
+ *
+ * name: _acquire_sample
+ *        : stores the sample of a finished sample-interval.
+ *        : HiRes: the average of all conversions is rounded to the 6bit
+ *        :  sample-value instead of truncating a single conversion,
+ *        :  which lowers the noise on slow sample-times a lot.
+ *        : Peak : min and max are stored as pair on every second
+ *        :  sample-interval, so short pulses aren't lost between samples.
+ * @param  channel_nr_t eChannel
+ * @param  acquire_t * pacquire
+ * @param  uint8_t value  sample-value of the current conversion
+ * @return none
+ *
+ */
+static inline void _acquire_sample(const channel_nr_t eChannel, acquire_t * pacquire, uint8_t value)
+{
+  switch (_acquisition) {
+    case SET_ACQ_HIRES:
+      value = (uint8_t)((pacquire->sum + 8UL * pacquire->count) / (16UL * pacquire->count));
+      _acquire_clear(pacquire);
+    break;
+    case SET_ACQ_PEAK:
+      if (pacquire->odd == false) {
+        pacquire->odd = true;
+        return;
+      }
+      //min is stored first, the max follows below
+      if (eChannel == eChannel_nr1) {
+        _store_channel1(pacquire->min);
+      } else {
+        _store_channel2(pacquire->min);
+      }
+      value = pacquire->max;
+      _acquire_clear(pacquire);
+    break;
+    default:
+    break;
+  }
+  if (eChannel == eChannel_nr1) {
+    _store_channel1(value);
+  } else {
+    _store_channel2(value);
+  }
+}
+
+/*!
+ *
+ * name: _sample_ets
+ *        : stores one sample on equivalent-time sampling (ETS).
+ *        : the slot is given by the time between trigger-edge (ICR1)
+ *        : and sample-tick (OCR1B), so many trigger-events are filling
+ *        : the buffer with an effective sample-time of ETS_SLOT_CYCLES.
+ *        : A frame is finished if all slots are filled or after
+ *        : ETS_MAX_TRIGGERS trigger-events.
+ * @param  uint8_t  value       sample-value
+ * @param  uint16_t sample_time timer1-value of the sample-tick
+ * @return none
+ *
+ */
+static inline void _sample_ets(const uint8_t value, const uint16_t sample_time)
+{
+  if (_ets_armed) {
+    int16_t delay = (int16_t)(sample_time - _ets_trigger);
+    if (delay >= 0) {
+      if (delay < (int16_t)(SAMPLE_DATA_SIZE * ETS_SLOT_CYCLES)) {
+        uint8_t slot = (uint16_t)delay / ETS_SLOT_CYCLES;
+        uint8_t mask = (uint8_t)(1<<(slot & 0x07));
+        pchannel1->data[slot] = value;
+        if ((_ets_filled[slot/8] & mask) == 0) {
+          _ets_filled[slot/8] |= mask;
+          _ets_slots++;
+        }
+      } else {
+        // end of frame-window, wait for next trigger-edge
+        _ets_armed = false;
+        if ((_ets_slots >= SAMPLE_DATA_SIZE) || (_ets_triggers >= ETS_MAX_TRIGGERS)) {
+          _frame_count++;
+          g_cfg.chan[eChannel_nr1].sample_start = false;
+          g_cfg.chan[eChannel_nr1].sample_draw  = true;
+        }
+      }
+    }
+  }
+}
+
+/*!
+ *
+ * name: _holdoff_expired
+ *        : checks the trigger-holdoff on a trigger-edge and restarts
+ *        : it, if the edge is accepted.
+ * @param  none
+ * @return true, if the edge is accepted, else false
+ *
+ */
+static inline bool _holdoff_expired(void)
+{
+  if (_holdoff_mode == SET_HOLDOFF_TIME) {
+    unsigned long int now = micros();
+    if ((now - _holdoff_start) < _holdoff_usec) {
+      return false;
+    }
+    _holdoff_start = now;
+  } else if (_holdoff_mode == SET_HOLDOFF_EDGES) {
+    if (_holdoff_edges > 0) {
+      _holdoff_edges--;
+      return false;
+    }
+    _holdoff_edges = _holdoff_count;
+  }
+  return true;
+}
+
+/*!
+ *
+ * name: _divider_passed
+ *        : counts the trigger-edges for the trigger-divider.
+ * @param  none
+ * @return true on the Nth edge, else false
+ *
+ */
+static inline bool _divider_passed(void)
+{
+  if (_divider_count >= _divider) {
+    //Nth edge after reset has triggered already
+    return false;
+  }
+  if (++_divider_count < _divider) {
+    return false;
+  }
+  if (_divider_reset == false) {
+    _divider_count = 0;
+  }
+  return true;
+}
+
+/*!
+ *
+ * name: _divider_reset_pulse
+ *        : restarts the trigger-divider on a rising reset-pulse in the
+ *        : 10bit-conversions of channel2.
+ * @param  uint16_t conversion  10bit ADC-value
+ * @return none
+ *
+ */
+static inline void _divider_reset_pulse(const uint16_t conversion)
+{
+  if (conversion < DIV_RESET_LOW) {
+    _reset_armed = true;
+  } else if (_reset_armed && (conversion >= DIV_RESET_HIGH)) {
+    _reset_armed = false;
+    _divider_count = 0;
+  }
+}
+
+/*!
+ *
+ * name: _trigger_event
+ *        : starts a triggered frame on a trigger-edge of the analog
+ *        : comparator or of the software trigger. Edges within the
+ *        : holdoff are ignored completely, edges dropped by the
+ *        : trigger-divider are counted for the trigger-rate.
+ * @param  uint16_t stamp  timer1 time-stamp of the trigger
+ * @return true, if a frame is started on the sample-tick, else false
+ *
+ */
+static inline bool _trigger_event(const uint16_t stamp)
+{
+  bool started = false;
+  if (_single_mode && (_single_armed == false)) {
+    //single-shot is captured or kept
+    return false;
+  }
+  if (_holdoff_expired() == false) {
+    return false;
+  }
+  if (( g_cfg.chan[eChannel_nr1].trigger_mode != SET_OFF ) && _divider_passed()) {
+    if ((_sample_step == TIMER1_SAMPLE_BURST) || (_sample_step == TIMER1_SAMPLE_ETS)) {
+      //single buffered: nothing is sampled until the frame is drawn
+      if (g_cfg.chan[eChannel_nr1].sample_draw) {
+        _missed_triggers++;
+      } else if (_sample_step == TIMER1_SAMPLE_BURST) {
+        //capture the complete buffer right now
+        _sample_burst();
+        _frame_count++;
+        _single_armed = false;
+        g_cfg.chan[eChannel_nr1].sample_draw = true;
+      } else if (_ets_armed == false) {
+        if ( g_cfg.chan[eChannel_nr1].sample_start == false ) {
+          //start a new ETS-frame
+          for (uint8_t x = 0; x < (SAMPLE_DATA_SIZE/8); x++) {
+            _ets_filled[x] = 0;
+          }
+          _ets_slots = 0;
+          _ets_triggers = 0;
+          g_cfg.chan[eChannel_nr1].sample_start = true;
+        }
+        //time-stamp of the comparator-edge, captured by timer1
+        _ets_trigger = ICR1;
+        _ets_triggers++;
+        _ets_armed = true;
+      }
+    } else if ((_acquisition == SET_ACQ_SEGMENT) && (_segment_fill >= _segment_count)) {
+      //segmented memory is complete, kept for review
+      _missed_triggers++;
+    } else if (_acquisition == SET_ACQ_DEEP) {
+      if (( g_cfg.chan[eChannel_nr1].sample_start == false ) &&
+          ( g_cfg.chan[eChannel_nr1].sample_draw  == false ) &&
+          (_deep_pre_filled >= _deep_pre)) {
+        //latch trigger-position, the frame starts _deep_pre before
+        _deep_start = (_deep_index - _deep_pre) & DEEP_INDEX_MASK;
+        _deep_post = DEEP_SAMPLES - _deep_pre;
+        _sample_counter1 = 0;
+        g_cfg.chan[eChannel_nr1].sample_start = true;
+        started = true;
+      } else {
+        _missed_triggers++;
+      }
+    } else if (( g_cfg.chan[eChannel_nr1].sample_start == false ) &&
+               (_pre_filled1 >= _pre_samples)) {
+      //latch trigger-position, the frame starts _pre_samples before.
+      //  first post-trigger sample on next sample-tick
+      _pchannel1_back->start = (_pchannel1_back->index - _pre_samples) & SAMPLE_INDEX_MASK;
+      _post_count1 = SAMPLE_DATA_SIZE - _pre_samples;
+      _sample_counter1 = 0;
+      _trigger_stamp = stamp;
+      if (_pchannel2_back != NULL) {
+        //same trigger-position on channel2 for best drawing
+        _pchannel2_back->start = (_pchannel2_back->index - _pre_samples) & SAMPLE_INDEX_MASK;
+      }
+      _post_count2 = SAMPLE_DATA_SIZE - _pre_samples;
+      _sample_counter2 = 0;
+      g_cfg.chan[eChannel_nr1].sample_start = true;
+      g_cfg.chan[eChannel_nr2].sample_start = true;
+      started = true;
+  //  Testpin Toggle PortC PC5
+  //PINC = (1<<PINC5);
+    } else {
+      //frame is running or pre-trigger samples are missing
+      _missed_triggers++;
+    }
+  }
+  _Trigger_Timeout=millis();
+  if (_trigger_edges++ == 0) {
+    _trigger_first = _Trigger_Timeout;
+  }
+  if (started) {
+    _single_armed = false;
+  }
+  return started;
+}
+
+/*!
+ *
+ * name: _phase_lock
+ *        : restarts the sample-tick phase-locked to a comparator-edge,
+ *        : the first post-trigger sample is converted TIMER1_PHASE_DELAY
+ *        : after the edge instead of on the free running tick. timer1
+ *        : keeps running for the frequency-measurement, only the
+ *        : compare-value is moved. The free running tick is kept, if
+ *        : the ADC is busy, the tick is due or the delay has passed.
+ * @param  uint16_t stamp  timer1 time-stamp of the edge
+ * @return none
+ *
+ */
+static inline void _phase_lock(const uint16_t stamp)
+{
+  uint16_t now = TCNT1;
+  uint16_t ahead = stamp + TIMER1_PHASE_DELAY - now;
+  if (_adc_chan2_active || (ADCSRA & ((1<<ADSC)|(1<<ADIF)))) {
+    return;
+  }
+  if (((uint16_t)(OCR1B - now) < TIMER1_PHASE_MARGIN) ||
+      (ahead < TIMER1_PHASE_MARGIN) || (ahead > TIMER1_PHASE_DELAY))
+  {
+    return;
+  }
+  OCR1B = now + ahead;
+  TIFR1 = (1<<OCF1B);
+}
+
+/*!
+ *
+ * name: _qualify_edge
+ *        : trigger-qualifier on every comparator-edge. The start of a
+ *        : pulse is time-stamped by the timer1 input capture, its end
+ *        : triggers, if the pulse-width is matching.
+ *        : every edge restarts the dropout-time.
+ * @param  none
+ * @return none
+ *
+ */
+static inline void _qualify_edge(void)
+{
+  uint16_t now = TCNT1;
+  if (_qualifier == SET_QUAL_DROPOUT) {
+    _edge_stamp = now;
+  } else if ((ACSR & (1<<ACO)) == _qual_aco_begin) {
+    _edge_stamp = ICR1;
+    _qual_pulse = true;
+  } else {
+    if (_qual_pulse) {
+      bool elapsed = _qual_elapsed ||
+                     ((_edge_ticks + (uint16_t)(now - _edge_stamp)) >= _qual_ticks);
+      if ((elapsed == (_qualifier == SET_QUAL_WIDER)) && _trigger_event(now)) {
+        _phase_lock(now);
+      }
+    }
+    _qual_pulse = false;
+    _edge_stamp = now;
+  }
+  _edge_ticks = 0;
+  _qual_elapsed = false;
+}
+
+/*!
+ *
+ * name: _qualify_tick
+ *        : extends the time since the last comparator-edge on every
+ *        : sample-tick, the tick-distance is always below the 16bit
+ *        : timer1-range. Dropout triggers once, if the time elapses.
+ * @param  none
+ * @return none
+ *
+ */
+static inline void _qualify_tick(void)
+{
+  if (_qual_elapsed == false) {
+    uint16_t now = TCNT1;
+    _edge_ticks += (uint16_t)(now - _edge_stamp);
+    _edge_stamp = now;
+    if (_edge_ticks >= _qual_ticks) {
+      _qual_elapsed = true;
+      if (_qualifier == SET_QUAL_DROPOUT) {
+        _trigger_event(now);
+      }
+    }
+  }
+}
+
+/*!
+ *
+ * name: _software_trigger
+ *        : software trigger on every 10bit-conversion of the selected
+ *        : channel. The trigger is armed by a conversion beyond the
+ *        : hysteresis, the next one reaching the level triggers.
+ * @param  uint16_t conversion  10bit ADC-value
+ * @return none
+ *
+ */
+static inline void _software_trigger(const uint16_t conversion)
+{
+  if (_swtrig_rising) {
+    if (conversion < _swtrig_arm) {
+      _swtrig_armed = true;
+    } else if (_swtrig_armed && (conversion >= _swtrig_level)) {
+      _swtrig_armed = false;
+      _trigger_event(_sample_stamp);
+    }
+  } else {
+    if (conversion > _swtrig_arm) {
+      _swtrig_armed = true;
+    } else if (_swtrig_armed && (conversion <= _swtrig_level)) {
+      _swtrig_armed = false;
+      _trigger_event(_sample_stamp);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////
+// ISR - handlers aren't used for Timer0, Timer1 and Timer2
+//  they are used for:
+//   Timer0: millis() / micros()
+//   Timer1: frequency-measurement, compare match B triggers the ADC
+//   Timer2: PWM offset-voltage channel1
+////////////////////////////////////////////////////////////////
+
+/*!
+ *
+ * name: ISR interrupt-service routine
+ * @brief  Interrupt Service for ADC conversion complete.
+ *         channel1 (A0) is converted on every timer1 compare match B,
+ *         channel2 (A1) is started here after channel1, if required.
+ *         Nothing waits for a conversion, so the time spent here
+ *         can be measured on testpin PC5 (high while running).
+ * @param  none
+ * @return none
+ *
+ */
+ISR(ADC_vect)
+{
+  ///// testpin options, activate as required
+  // Testpin Toggle PortC PC5
+  // PINC = (1<<PINC5);
+  // set Testpin high or
+  PORTC |= (1<<PORTC5);
+  /////
+  uint16_t conversion;
+  uint8_t value;
+  if (_admux_base & (1<<ADLAR)) {
+    //fast acquisition: get 8bit left adjusted value from ADCH only
+    conversion = ADCH*4;
+  } else {
+    //get value from ADCL/ADCH
+    conversion = ADC;
+  }
+  value = conversion/16;
+
+  if (_adc_chan2_active) {
+    // channel2 conversion finished, set channel A0 for next trigger
+    ADMUX = _admux_base;
+    _adc_chan2_active = false;
+    if (TIFR1 & (1<<OCF1B)) {
+      // sample-tick passed while channel2 was converting, the ADC missed
+      //  the trigger: restart from now and clear compare-flag to rearm
+      OCR1B = TCNT1 + _compare_step;
+      TIFR1 = (1<<OCF1B);
+    }
+    if (pchannel2 != NULL) {
+      if (_swtrig_channel == 2) {
+        _software_trigger(conversion);
+      }
+      if (_divider_reset) {
+        _divider_reset_pulse(conversion);
+      }
+      if (_acquire_ticks) {
+        _acquire_conversion(&_acquire2, conversion);
+      }
+      if (_adc_chan2_due) {
+        _acquire_sample(eChannel_nr2, &_acquire2, value);
+      }
+    }
+  } else {
+    // time-stamp of this sample is the compare-value
+    uint16_t sample_time = OCR1B;
+    _sample_stamp = sample_time;
+    uint16_t step = _compare_step;
+    if (_sample_step == TIMER1_SAMPLE_ETS) {
+      // dithered sample-tick on ETS, the samples are moving against
+      //  the trigger-edge, even on signal-periods matching the tick
+      _ets_dither = (_ets_dither + 13) & ETS_DITHER_MASK;
+      step += _ets_dither;
+    } else if (_compare_fraction != 0) {
+      // fine sample-time: the fraction carries into the compare-step
+      _compare_phase += _compare_fraction;
+      step += _compare_phase >> TIMER1_FINE_SHIFT;
+      _compare_phase &= (TIMER1_FINE_ONE-1);
+    }
+    // next sample-tick and clear compare-flag to rearm the ADC-trigger
+    OCR1B = sample_time + step;
+    if ((uint16_t)(OCR1B - TCNT1) > step) {
+      // next tick already passed (fast acquisition), restart from now
+      OCR1B = TCNT1 + step;
+    }
+    TIFR1 = (1<<OCF1B);
+
+    if (_swtrig_channel == 1) {
+      _software_trigger(conversion);
+    }
+    if (_qualifier != SET_QUAL_EDGE) {
+      _qualify_tick();
+    }
+    if (_acquire_ticks) {
+      //every conversion is collected until the sample is due
+      _acquire_conversion(&_acquire1, conversion);
+    }
+    if (_sample_step == TIMER1_SAMPLE_ETS) {
+      _sample_ets(value, sample_time);
+    } else if ((g_cfg.chan[eChannel_nr1].trigger_mode == SET_OFF) &&
+               (g_cfg.chan[eChannel_nr1].sample_start == false)) {
+      //free running, waiting for drawing
+      _sample_counter1  = _counter_reload1;
+      _acquire_clear(&_acquire1);
+    } else if (_sample_counter1 > 0) {
+      _sample_counter1--;
+    } else {
+      _acquire_sample(eChannel_nr1, &_acquire1, value);
+      _sample_counter1  = _counter_reload1;
+    }
+    //sample channel2, if required. Free running channel2 waits for drawing,
+    //  except on roll-mode: both channels are drawn sample by sample
+    if ((g_cfg.chan[eChannel_nr1].trigger_mode != SET_OFF) || \
+        (_acquisition == SET_ACQ_ROLL) || \
+        (g_cfg.chan[eChannel_nr2].sample_draw  == false)) {
+      if ((g_cfg.chan[eChannel_nr2].status == 1) || \
+          (g_cfg.chan[eChannel_nr1].option  == SET_OPT_DUAL_PLUGGED)
+        )
+      {
+        if (_sample_counter2 > 0) {
+          _sample_counter2--;
+          _adc_chan2_due = false;
+        } else {
+          _adc_chan2_due = true;
+          _sample_counter2  = _counter_reload2;
+        }
+        if (_adc_chan2_due || _acquire_ticks) {
+          // set channel A1 -->> (1<<MUX0) and start the ADC-conversion,
+          //  result is stored on next ADC-interrupt
+          ADMUX = _admux_base|(1<<MUX0);
+          _adc_chan2_active = true;
+          ADCSRA |= (1<<ADSC);
+        }
+      }
+    }
+  }
+  ///// testpin options, activate as required
+  //set Testpin low
+  PORTC &= (uint8_t)~(1<<PORTC5);
+} //end ADC_vect
+
+/*!
+ *
+ * name: ISR interrupt-service routine
+ * @brief  Interrupt Service for Analog Comparator.
+ *         low-latency trigger, unused on software trigger.
+ *         with trigger-qualifier on both edges.
+ *         the sample-tick is phase-locked to the trigger-edge.
+ * @param  none
+ * @return none
+ *
+ */
+ISR(ANALOG_COMP_vect)
+{
+  // Testpin Toggle PortC PC5
+  //PINC = (1<<PINC5);
+
+  if (_qualifier == SET_QUAL_EDGE) {
+    uint16_t stamp = ICR1;
+    if (_trigger_event(stamp)) {
+      _phase_lock(stamp);
+    }
+  } else {
+    _qualify_edge();
+  }
 }
@@ -41,20 +41,56 @@
     #define F_CPU 16000000UL
   #endif
 
+  //SAMPLE_DATA_SIZE has to be a power of 2 for the ring-buffer
+  #define SAMPLE_INDEX_MASK  (SAMPLE_DATA_SIZE-1)
+  //DEEP_SAMPLES has to be a power of 2 and a multiple of 4 samples too
+  #define DEEP_INDEX_MASK    (DEEP_SAMPLES-1)
+
   typedef struct sample {
     uint8_t data[SAMPLE_DATA_SIZE];
-    uint8_t index;
+    uint8_t index;  //next write-position
+    uint8_t start;  //first sample of the frame (ring-buffer)
+    int16_t delay;  //timer1 clocks from the trigger to the first
+                    //  post-trigger sample
   } sample_t;
 
-  //channel1 sample-data
-  extern sample_t channel1;
-  //pointer to channel2 sample-data for dynamic assignment
+  //pointer to channel1 sample-data (front-buffer for drawing)
+  extern sample_t * pchannel1;
+  //pointer to channel2 sample-data for dynamic assignment (front-buffer)
   extern sample_t * pchannel2;
 
   void sample_init( void );
   void set_counter_defaults( void );
+  void sample_alloc_channel2(const bool enable);
+  void sample_alloc_segments(const bool enable);
+  void sample_alloc_average(const bool enable);
+  void sample_alloc_deep(const bool enable);
+  uint8_t sample_deep_at(const uint16_t x);
+  uint8_t sample_average_frame( void );
+  uint8_t sample_average_at(const uint8_t x);
+  uint8_t sample_segments( void );
+  const sample_t * sample_segment(const uint8_t segment);
+  void sample_get_statistics(uint16_t * pframes, uint16_t * pmissed);
+  uint16_t sample_trigger_rate(const uint16_t elapsed);
+  void sample_single_arm( void );
+  bool sample_single_armed( void );
+  uint32_t sample_trigger_usec(const uint8_t index);
+  uint8_t sample_acquisition( void );
+  uint32_t sample_interval(const channel_nr_t eChannel);
+  bool sample_get_range(uint8_t * pmin, uint8_t * pmax);
+  void sample_clear_range( void );
+  void sample_burst( void );
   bool is_triggertimeout(channel_nr_t eChannel, const uint8_t menu_timeout);
 
+  /*!
+   * name: sample_at
+   *        : sample-value at frame-position x, the frame is read
+   *        : rotated around its start, nothing is copied.
+   */
+  static inline uint8_t sample_at(const sample_t * psample, const uint8_t x) {
+    return psample->data[(uint8_t)(psample->start + x) & SAMPLE_INDEX_MASK];
+  }
+
 #if defined (__cplusplus)
 } //extern "C"
 #endif
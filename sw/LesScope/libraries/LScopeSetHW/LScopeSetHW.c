@@ -27,6 +27,12 @@
 #include "LScopeCfg.h"
 #include "LScopeSetHW.h"
 
+//auto-range: amplifier-level of channel1 in use on SET_AMP_AUTO
+uint8_t _amp_auto_level=SET_AMP_LEVEL_1;
+//level waiting for the settled offset-voltage, 0:= none, and its start
+uint8_t _amp_pending_level=0;
+unsigned long int _amp_pending_time=0L;
+
 /*!
  *
  * name: hw_init
@@ -65,7 +71,7 @@ void hw_init(void) {
     TCCR1B |= (1<<ICNC1);
     TCCR1B &= (uint8_t)~(1<<ICES1);
 
-    // setup Timer2 for PWM on D3(OC2B) and sample-timesteps
+    // setup Timer2 for PWM on D3(OC2B), sample-timesteps are done by Timer1
     // disable powersaving mode for Timer2
     PRR &= (uint8_t)~(PRTIM2);
     // setup:clear OC2B on compare and Fast PWM Mode:7
@@ -82,67 +88,98 @@ void hw_init(void) {
   } //end ATOMIC_BLOCK()
 }
 
+/*!
+ *
+ * name: _set_offset_chan1
+ * @brief  sets the PWM offset-voltage of channel1 for an amplifier-level.
+ *         This offset (PWM) depends on Timer2 'OCR2A' value: TIMER2_SAMPLE
+ *         see: sample_init() in modul: LScopeSample.c
+ * @param  uint8_t level  SET_AMP_LEVEL_x
+ * @return none
+ *
+ */
+static void _set_offset_chan1(const uint8_t level) {
+  switch (level) {
+    case SET_AMP_LEVEL_2:
+      //offset channel1 = 1.25V set with PWM 25%
+      analogWrite(OFFSETPIN_OUT_CHAN1, TIMER2_SAMPLE / 4);
+    break;
+    case SET_AMP_LEVEL_3:
+      //offset channel1 = 0.625V set with PWM 12,5%
+      analogWrite(OFFSETPIN_OUT_CHAN1, TIMER2_SAMPLE / 8);
+    break;
+    case SET_AMP_LEVEL_4:
+      //offset channel1 = 0.32V set with PWM 6,25%
+      analogWrite(OFFSETPIN_OUT_CHAN1, TIMER2_SAMPLE / 16);
+    break;
+    default:
+      //offset channel1 = 2.5V set with PWM 50%
+      analogWrite(OFFSETPIN_OUT_CHAN1, TIMER2_SAMPLE / 2);
+    break;
+  }
+}
+
+/*!
+ *
+ * name: _set_gain_chan1
+ * @brief  sets the amplification-ports of channel1 for an amplifier-level.
+ *         levels above 1 require the settled offset-voltage.
+ * @param  uint8_t level  SET_AMP_LEVEL_x
+ * @return none
+ *
+ */
+static void _set_gain_chan1(const uint8_t level) {
+  switch (level) {
+    case SET_AMP_LEVEL_2:
+      digitalWrite(A2, 0);
+      //set port to output for amplification * 2
+      pinMode(A2, OUTPUT);
+      pinMode(A4, INPUT);
+    break;
+    case SET_AMP_LEVEL_3:
+      pinMode(A2, INPUT);
+      //set port to output for amplification * 3
+      digitalWrite(A4, 0);
+      pinMode(A4, OUTPUT);
+    break;
+    case SET_AMP_LEVEL_4:
+      digitalWrite(A2, 0);
+      pinMode(A2, OUTPUT);
+      //set port to output for amplification * 4
+      digitalWrite(A4, 0);
+      pinMode(A4, OUTPUT);
+    break;
+    default:
+      //set port to input for amplification * 1
+      pinMode(A2, INPUT);
+      pinMode(A4, INPUT);
+    break;
+  }
+}
+
 /*!
  *
  * name: set_amplifier
     @brief  amplifier set to sig-in*1 or *2 factor.
+            channel1 on auto-range uses the level of the last
+            set_amplifier_level().
     @param  echannel_nr: channel-number to be set.
 */
 void set_amplifier(const channel_nr_t echannel_nr) {
+  uint8_t level;
 
   switch(echannel_nr) {
     // setup channel 1
     case eChannel_nr1:
-      // This offset (PWM) depends on Timer2 'OCR2A' value: TIMER2_SAMPLE
-         // see: sample_init() in modul: LScopeSample.c
       pinMode(OFFSETPIN_OUT_CHAN1, OUTPUT) ;//offset voltage-Channel1 activate
-      switch (g_cfg.chan[eChannel_nr1].amplifier) {
-        case SET_AMP_LEVEL_1:
-          //offset channel1 = 2.5V set with PWM 50%
-          analogWrite(OFFSETPIN_OUT_CHAN1, TIMER2_SAMPLE / 2);
-          //set port to input for amplification * 1
-          pinMode(A2, INPUT);
-          pinMode(A4, INPUT);
-        break;
-        case SET_AMP_LEVEL_2:
-          //offset channel1 = 1.25V set with PWM 25%
-          analogWrite(OFFSETPIN_OUT_CHAN1, TIMER2_SAMPLE / 4);
-          //wait for PWM offset set
-          delay(100L);
-          digitalWrite(A2, 0);
-          //set port to output for amplification * 2
-          pinMode(A2, OUTPUT);
-          pinMode(A4, INPUT);
-        break;
-        case SET_AMP_LEVEL_3:
-          //offset channel1 = 0.625V set with PWM 12,5%
-          analogWrite(OFFSETPIN_OUT_CHAN1, TIMER2_SAMPLE / 8);
-          //wait for PWM offset set
-          delay(100L);
-          pinMode(A2, INPUT);
-          //set port to output for amplification * 3
-          digitalWrite(A4, 0);
-          pinMode(A4, OUTPUT);
-        break;
-        case SET_AMP_LEVEL_4 :
-          //offset channel1 = 0.32V set with PWM 6,25%
-          analogWrite(OFFSETPIN_OUT_CHAN1, TIMER2_SAMPLE / 16);
-          //wait for PWM offset set
-          delay(100L);
-          digitalWrite(A2, 0);
-          pinMode(A2, OUTPUT);
-          //set port to output for amplification * 4
-          digitalWrite(A4, 0);
-          pinMode(A4, OUTPUT);
-        break;
-        default:
-          //offset channel1 = 2.5V set with PWM 50%
-          analogWrite(OFFSETPIN_OUT_CHAN1, TIMER2_SAMPLE / 2);
-          //set port to input for amplification * 1
-          pinMode(A2, INPUT);
-          pinMode(A4, INPUT);
-        break;
+      level = amplifier_level();
+      _amp_pending_level = 0;
+      _set_offset_chan1(level);
+      if ((level > SET_AMP_LEVEL_1) && (level <= SET_AMP_LEVEL_4)) {
+        //wait for PWM offset set
+        delay(AMP_SETTLE_MSEC);
       }
+      _set_gain_chan1(level);
 /*
       if (g_cfg.chan[eChannel_nr1].amplifier == SET_AMP_LEVEL_2) {
         //offset channel1 = 1.25V set with PWM 25%
@@ -193,6 +230,59 @@ void set_amplifier(const channel_nr_t echannel_nr) {
   }
 }
 
+/*!
+ *
+ * name: set_amplifier_level
+ * @brief  auto-range: sets a new amplifier-level on channel1 without
+ *         waiting. The offset-voltage is set at once, the amplification
+ *         follows in amplifier_settling(), after it is settled.
+ * @param  uint8_t level  SET_AMP_LEVEL_x
+ * @return none
+ *
+ */
+void set_amplifier_level(const uint8_t level) {
+  _amp_auto_level = level;
+  _set_offset_chan1(level);
+  _amp_pending_level = level;
+  _amp_pending_time = millis();
+}
+
+/*!
+ *
+ * name: amplifier_settling
+ * @brief  auto-range: switches the amplification of a pending
+ *         set_amplifier_level(), after the offset-voltage is settled.
+ *         Has to be called cyclic in main-loop.
+ * @param  none
+ * @return true while a level is pending, also on the switching call.
+ *
+ */
+bool amplifier_settling(void) {
+  if (_amp_pending_level == 0) {
+    return false;
+  }
+  if ((millis() - _amp_pending_time) >= AMP_SETTLE_MSEC) {
+    _set_gain_chan1(_amp_pending_level);
+    _amp_pending_level = 0;
+  }
+  return true;
+}
+
+/*!
+ *
+ * name: amplifier_level
+ * @brief  amplifier-level of channel1 in use, also on auto-range.
+ * @param  none
+ * @return uint8_t  SET_AMP_LEVEL_x
+ *
+ */
+uint8_t amplifier_level(void) {
+  if (g_cfg.chan[eChannel_nr1].amplifier == SET_AMP_AUTO) {
+    return _amp_auto_level;
+  }
+  return g_cfg.chan[eChannel_nr1].amplifier;
+}
+
 /*!
  * name: set_trigger_mode
     @brief  function set the triggermode on selected channel for
@@ -202,6 +292,12 @@ void set_amplifier(const channel_nr_t echannel_nr) {
               *                 without trigger, empty line is drawn.
               3. Mode: Normal-> triggered sampling and display.
               *                 without trigger, nothing drawn.
+              4. Mode: Single-> one triggered frame is kept,
+              *                 see: sample_single_arm().
+              The comparator-interrupt stays disabled on software
+              trigger, see: set_counter_defaults() in LScopeSample.c.
+              trigger-qualifiers are using both comparator-edges,
+              the input capture stays on the starting edge.
               !! Make sure calling this with cli() interrupts disabled !!
         @param  eChannel_nr: channel-number to be set.
 */
@@ -222,26 +318,51 @@ void set_trigger_mode(const channel_nr_t eChannel_nr) {
       // timeout-check on main-loop with 'is_triggertimeout()'.
       // no break required
     case SET_TRIG_NORM_P :
+      // no break required
+    case SET_TRIG_SINGLE_P :
       if (eChannel_nr == eChannel_nr1) {
         ACSR &= (uint8_t)~(1<<ACIE);  //Analog Comparator Interrupt disable
         ACSR &= (uint8_t)~(1<<ACIS0); //clear settingmode-flag: 0
         ACSR |= (1<<ACIS1); //Analog Comparator Interrupt on falling edge
-        ACSR |= (1<<ACIE);  //Analog Comparator Interrupt enable
+        //timer1 input capture on the same edge (trigger time-stamp)
+        TCCR1B &= (uint8_t)~(1<<ICES1);
+        TIFR1 = (1<<ICF1);
+        if (g_cfg.chan[eChannel_nr1].trigger_level < SET_TRIG_LEVEL_SOFT1) {
+          ACSR |= (1<<ACIE);  //Analog Comparator Interrupt enable
+        }
       }
     break;
     case SET_TRIG_AUTO_N :
       // timeout-check on main-loop with 'is_triggertimeout()'.
       // no break required
     case SET_TRIG_NORM_N :
+      // no break required
+    case SET_TRIG_SINGLE_N :
       if (eChannel_nr == eChannel_nr1) {
         ACSR &= (uint8_t)~(1<<ACIE);  //Analog Comparator Interrupt disable
         ACSR |= ((1<<ACIS1)|(1<<ACIS0)); //Analog Comparator Interrupt on rising edge
-        ACSR |= (1<<ACIE);  //Analog Comparator Interrupt enable
+        //timer1 input capture on the same edge (trigger time-stamp)
+        TCCR1B |= (1<<ICES1);
+        TIFR1 = (1<<ICF1);
+        if (g_cfg.chan[eChannel_nr1].trigger_level < SET_TRIG_LEVEL_SOFT1) {
+          ACSR |= (1<<ACIE);  //Analog Comparator Interrupt enable
+        }
       }
     break;
     default :
     break;
   }
+  if ((eChannel_nr == eChannel_nr1) &&
+      (g_cfg.chan[eChannel_nr1].trigger_mode != SET_OFF) &&
+      (g_cfg.chan[eChannel_nr1].trigger_qual != SET_QUAL_EDGE))
+  {
+    //Analog Comparator Interrupt on toggle, the mode is changed with
+    //  interrupt disabled and a cleared interrupt-flag
+    uint8_t enabled = ACSR & (1<<ACIE);
+    ACSR &= (uint8_t)~(1<<ACIE);
+    ACSR &= (uint8_t)~((1<<ACIS1)|(1<<ACIS0));
+    ACSR |= (1<<ACI) | enabled;
+  }
 }
 
 /*!
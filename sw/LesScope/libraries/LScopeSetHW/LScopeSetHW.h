@@ -41,9 +41,14 @@
 #define OFFSET_5_0_VOLT  255
 #define OFFSET_2_5_VOLT  127
 #define OFFSET_1_25_VOLT  63
+//settling-time of the PWM offset-voltage before switching the amplification
+#define AMP_SETTLE_MSEC  100L
 
 void hw_init(void);
 void set_amplifier(const channel_nr_t echannel_nr);
+void set_amplifier_level(const uint8_t level);
+bool amplifier_settling(void);
+uint8_t amplifier_level(void);
 void set_trigger_mode(const channel_nr_t eChannel_nr);
 void set_trigger_level(void);
 
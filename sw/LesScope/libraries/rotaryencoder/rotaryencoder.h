@@ -74,6 +74,7 @@ class CRotaryEncoder : public Encoder
     Button_t getButtonState(void);
     bool up(void)  { bool rtn_value=_upstate; _upstate=false; return rtn_value; }
     bool down(void){ bool rtn_value=_downstate; _downstate=false; return rtn_value; }
+    bool turned(void) { return (_upstate || _downstate); }
 
   private:
     uint8_t _port_ENC_PUSH;